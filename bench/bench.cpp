@@ -0,0 +1,119 @@
+// Micro-benchmarks of the board operations in sweepminer_core. They run without a window or audio device.
+//
+// Usage: sweepminer_bench [--filter=<substring>] [--samples=<n>] [--warmup=<n>] [--min-time-ms=<n>] [--csv=<path>]
+
+#include <array>
+#include <format>
+#include <random>
+
+#include "benchmark.hpp"
+#include "board.hpp"
+#include "board_generation.hpp"
+
+namespace {
+    struct BoardSize {
+        const char* name;
+        uint8_t rows;
+        uint8_t columns;
+        uint8_t mines;
+    };
+
+    constexpr std::array<BoardSize, 5> BOARD_SIZES = {{
+        {"Beginner", 9, 9, 10},
+        {"Intermediate", 16, 16, 40},
+        {"Expert", 16, 30, 99},
+        {"Custom 64x64", 64, 64, 255},
+        {"Custom 255x255", 255, 255, 255},
+    }};
+
+    uint64_t DrainEvents(Board& board) {
+        uint64_t count = 0;
+        BoardEvent event{};
+
+        while (board.pollEvent(event)) {
+            count++;
+        }
+
+        return count;
+    }
+}
+
+int main(const int argc, char* argv[]) {
+    Benchmark::Options options{};
+
+    if (!Benchmark::parseOptions(argc, argv, options)) {
+        return 1;
+    }
+
+    Benchmark benchmark(options);
+    std::mt19937 generator(0x5eed);
+
+    Benchmark::printHeader();
+
+    for (const BoardSize& size: BOARD_SIZES) {
+        benchmark.run(std::format("Construct/{}", size.name), [&] {
+            const Board board(size.rows, size.columns, size.mines, generator);
+
+            return board.getSurroundingMines(size.rows - 1, size.columns - 1);
+        });
+    }
+
+    for (const BoardSize& size: BOARD_SIZES) {
+        benchmark.run(std::format("PlaceMines/{}", size.name), [&] {
+            const PaddedGrid<uint8_t> mines = PlaceMines(size.rows, size.columns, size.mines, generator);
+
+            return mines[mines.getIndex(size.rows - 1, size.columns - 1)];
+        });
+    }
+
+    for (const BoardSize& size: BOARD_SIZES) {
+        const PaddedGrid<uint8_t> mines = PlaceMines(size.rows, size.columns, size.mines, generator);
+
+        benchmark.run(std::format("CountSurroundingMines/{}", size.name), [&] {
+            const PaddedGrid<uint8_t> counts = CountSurroundingMines(mines);
+
+            return counts[counts.getIndex(size.rows - 1, size.columns - 1)];
+        });
+    }
+
+    for (const BoardSize& size: BOARD_SIZES) {
+        // Without mines every cell is empty, so one reveal floods the whole board
+        Board board(size.rows, size.columns, std::vector<uint8_t>(size.rows * size.columns, 0));
+
+        benchmark.run(std::format("RevealConnectedCells/{}", size.name), [&] {
+            board.revealConnectedCells(0, 0);
+
+            return static_cast<uint8_t>(board.getState(size.rows - 1, size.columns - 1));
+        });
+    }
+
+    for (const BoardSize& size: BOARD_SIZES) {
+        // Everything except the last cell is revealed, so every call scans the whole board and doesn't report a win
+        Board board(size.rows, size.columns, std::vector<uint8_t>(size.rows * size.columns, 0));
+
+        board.revealConnectedCells(size.rows - 1, size.columns - 1);
+
+        benchmark.run(std::format("CheckForVictory/{}", size.name), [&] {
+            return board.checkForVictory();
+        });
+    }
+
+    for (const BoardSize& size: BOARD_SIZES) {
+        // A full game from a fresh board: reveal a corner, then every cell still hidden that doesn't hold a mine
+        benchmark.run(std::format("PlayToVictory/{}", size.name), [&] {
+            Board board(size.rows, size.columns, size.mines, generator);
+
+            for (uint8_t row = 0; row < size.rows; row++) {
+                for (uint8_t column = 0; column < size.columns; column++) {
+                    if (!board.hasMine(row, column) && board.getState(row, column) == Board::CellState::HIDDEN) {
+                        board.reveal(row, column);
+                    }
+                }
+            }
+
+            return DrainEvents(board);
+        });
+    }
+
+    return benchmark.finish() ? 0 : 1;
+}
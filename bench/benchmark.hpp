@@ -0,0 +1,257 @@
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/**
+ * A small benchmark runner. Each benchmark's body is calibrated to a batch size that takes at least minSampleTime, run
+ * for a number of warmup batches, and then timed over a number of sample batches. Every sample is reported as the mean
+ * time of one call within its batch, and results summarise those samples with the median, mean and its 95% confidence
+ * interval, standard deviation, median absolute deviation and min/max.
+ *
+ * Bodies return a value derived from their work which is folded into a volatile sink, so the compiler can't drop them.
+ */
+class Benchmark {
+public:
+    struct Options {
+        size_t warmup{3};
+        size_t samples{30};
+        std::chrono::nanoseconds minSampleTime{std::chrono::milliseconds(10)};
+        std::string filter{};
+        std::string csvPath{};
+    };
+
+    struct Result {
+        std::string name;
+        uint64_t batchSize;
+        double median;
+        double mean;
+        double confidence;
+        double stddev;
+        double mad;
+        double min;
+        double max;
+    };
+
+    explicit Benchmark(Options options) : options(std::move(options)) {}
+
+    /**
+     * Parses --filter=, --samples=, --warmup=, --min-time-ms= and --csv=. Returns false on an unknown or invalid
+     * argument after printing the usage.
+     */
+    static bool parseOptions(const int argc, char* argv[], Options& options) {
+        for (int i = 1; i < argc; i++) {
+            const std::string_view arg = argv[i];
+            bool valid = true;
+
+            if (arg.starts_with("--filter=")) {
+                options.filter = arg.substr(9);
+            } else if (arg.starts_with("--csv=")) {
+                options.csvPath = arg.substr(6);
+            } else if (arg.starts_with("--samples=")) {
+                valid = parseCount(arg.substr(10), options.samples) && options.samples > 0;
+            } else if (arg.starts_with("--warmup=")) {
+                valid = parseCount(arg.substr(9), options.warmup);
+            } else if (arg.starts_with("--min-time-ms=")) {
+                size_t ms = 0;
+                valid = parseCount(arg.substr(14), ms);
+                options.minSampleTime = std::chrono::milliseconds(ms);
+            } else {
+                valid = false;
+            }
+
+            if (!valid) {
+                std::cerr << "Usage: " << argv[0]
+                          << " [--filter=<substring>] [--samples=<n>] [--warmup=<n>] [--min-time-ms=<n>] [--csv=<path>]\n";
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    template <typename Body>
+    void run(const std::string& name, Body&& body) {
+        if (!this->options.filter.empty() && name.find(this->options.filter) == std::string::npos) {
+            return;
+        }
+
+        uint64_t batchSize = 1;
+
+        // Double the batch until one takes long enough for the clock's resolution not to matter
+        while (this->time(body, batchSize) < this->options.minSampleTime && batchSize < (uint64_t{1} << 40)) {
+            batchSize *= 2;
+        }
+
+        for (size_t i = 0; i < this->options.warmup; i++) {
+            this->time(body, batchSize);
+        }
+
+        std::vector<double> samples(this->options.samples);
+
+        for (double& sample: samples) {
+            const auto elapsed = std::chrono::duration<double, std::nano>(this->time(body, batchSize));
+
+            sample = elapsed.count() / static_cast<double>(batchSize);
+        }
+
+        this->results.push_back(summarise(name, batchSize, samples));
+        this->print(this->results.back());
+    }
+
+    /**
+     * Writes the CSV file if one was requested. Returns false if it couldn't be written.
+     */
+    bool finish() const {
+        if (this->options.csvPath.empty()) {
+            return true;
+        }
+
+        std::ofstream output(this->options.csvPath, std::ios::trunc);
+        if (!output) {
+            std::cerr << "Couldn't open CSV file: " << this->options.csvPath << "\n";
+            return false;
+        }
+
+        output << "name,batch_size,median_ns,mean_ns,ci95_ns,stddev_ns,mad_ns,min_ns,max_ns\n";
+
+        for (const Result& result: this->results) {
+            output << std::format(
+                "{},{},{:.3f},{:.3f},{:.3f},{:.3f},{:.3f},{:.3f},{:.3f}\n",
+                result.name,
+                result.batchSize,
+                result.median,
+                result.mean,
+                result.confidence,
+                result.stddev,
+                result.mad,
+                result.min,
+                result.max);
+        }
+
+        return true;
+    }
+
+    static void printHeader() {
+        std::cout << std::format(
+            "{:<40} {:>10} {:>12} {:>22} {:>8} {:>12} {:>12}\n",
+            "Benchmark",
+            "Batch",
+            "Median",
+            "Mean (95% CI)",
+            "MAD",
+            "Min",
+            "Max");
+    }
+
+private:
+    Options options;
+    std::vector<Result> results{};
+
+    static inline volatile uint64_t sink = 0;
+
+    static bool parseCount(const std::string_view value, size_t& count) {
+        // Rejects signs, trailing characters and values that don't fit instead of throwing
+        const auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), count);
+
+        return error == std::errc{} && end == value.data() + value.size();
+    }
+
+    template <typename Body>
+    std::chrono::nanoseconds time(Body& body, const uint64_t batchSize) const {
+        uint64_t checksum = 0;
+
+        const auto start = std::chrono::steady_clock::now();
+
+        for (uint64_t i = 0; i < batchSize; i++) {
+            checksum += static_cast<uint64_t>(body());
+        }
+
+        const auto end = std::chrono::steady_clock::now();
+
+        sink = sink + checksum;
+
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start);
+    }
+
+    static double getMedian(std::vector<double> values) {
+        std::ranges::sort(values);
+
+        const size_t middle = values.size() / 2;
+
+        return values.size() % 2 == 0 ? (values[middle - 1] + values[middle]) / 2.0 : values[middle];
+    }
+
+    static Result summarise(const std::string& name, const uint64_t batchSize, const std::vector<double>& samples) {
+        const auto count = static_cast<double>(samples.size());
+
+        double sum = 0.0;
+
+        for (const double sample: samples) {
+            sum += sample;
+        }
+
+        const double mean = sum / count;
+
+        double squares = 0.0;
+
+        for (const double sample: samples) {
+            squares += (sample - mean) * (sample - mean);
+        }
+
+        const double stddev = samples.size() > 1 ? std::sqrt(squares / (count - 1.0)) : 0.0;
+        const double median = getMedian(samples);
+
+        std::vector<double> deviations(samples.size());
+
+        std::ranges::transform(samples, deviations.begin(), [median](const double sample) {
+            return std::abs(sample - median);
+        });
+
+        return Result{
+            .name = name,
+            .batchSize = batchSize,
+            .median = median,
+            .mean = mean,
+            .confidence = 1.96 * stddev / std::sqrt(count),
+            .stddev = stddev,
+            .mad = getMedian(deviations),
+            .min = std::ranges::min(samples),
+            .max = std::ranges::max(samples),
+        };
+    }
+
+    static std::string formatTime(const double ns) {
+        if (ns >= 1'000'000.0) {
+            return std::format("{:.3f} ms", ns / 1'000'000.0);
+        }
+
+        if (ns >= 1'000.0) {
+            return std::format("{:.3f} us", ns / 1'000.0);
+        }
+
+        return std::format("{:.1f} ns", ns);
+    }
+
+    void print(const Result& result) const {
+        std::cout << std::format(
+            "{:<40} {:>10} {:>12} {:>22} {:>7.1f}% {:>12} {:>12}\n",
+            result.name,
+            result.batchSize,
+            formatTime(result.median),
+            std::format("{} +/- {:.1f}%", formatTime(result.mean), result.confidence / result.mean * 100.0),
+            result.mad / result.median * 100.0,
+            formatTime(result.min),
+            formatTime(result.max));
+    }
+};
@@ -0,0 +1,63 @@
+# Generates a header that embeds every file under ASSETS_DIR as a constexpr byte array.
+#
+# Usage: cmake -DASSETS_DIR=<dir> -DOUTPUT=<header> -P embed_assets.cmake
+
+if (NOT ASSETS_DIR OR NOT OUTPUT)
+    message(FATAL_ERROR "ASSETS_DIR and OUTPUT must be set")
+endif ()
+
+file(GLOB_RECURSE ASSET_FILES RELATIVE "${ASSETS_DIR}" "${ASSETS_DIR}/*")
+list(SORT ASSET_FILES)
+
+# CMake regular expressions have no {n} quantifier, so spell out 16 bytes per line by hand
+set(LINE_PATTERN "")
+foreach (_ RANGE 15)
+    string(APPEND LINE_PATTERN "0x[0-9a-f][0-9a-f],")
+endforeach ()
+
+set(ARRAYS "")
+set(ENTRIES "")
+set(INDEX 0)
+
+foreach (ASSET_FILE IN LISTS ASSET_FILES)
+    file(READ "${ASSETS_DIR}/${ASSET_FILE}" HEX HEX)
+    file(SIZE "${ASSETS_DIR}/${ASSET_FILE}" SIZE)
+
+    string(REGEX REPLACE "([0-9a-f][0-9a-f])" "0x\\1," BYTES "${HEX}")
+    string(REGEX REPLACE "(${LINE_PATTERN})" "\\1\n        " BYTES "${BYTES}")
+    string(REGEX REPLACE "\n        $" "" BYTES "${BYTES}")
+
+    string(APPEND ARRAYS "    // assets/${ASSET_FILE}\n")
+    string(APPEND ARRAYS "    inline constexpr uint8_t ASSET_${INDEX}[${SIZE}] = {\n        ${BYTES}\n    };\n\n")
+    string(APPEND ENTRIES "        Asset{ .path = \"assets/${ASSET_FILE}\", .data = ASSET_${INDEX}, .size = ${SIZE} },\n")
+
+    math(EXPR INDEX "${INDEX} + 1")
+endforeach ()
+
+set(CONTENT "// Generated by cmake/embed_assets.cmake, do not edit.
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+namespace EmbeddedAssets {
+    struct Asset {
+        std::string_view path;
+        const uint8_t* data;
+        size_t size;
+    };
+
+${ARRAYS}    inline constexpr std::array<Asset, ${INDEX}> ASSETS = {
+${ENTRIES}    };
+}
+")
+
+# Only touch the header when the content changes so dependent sources aren't rebuilt needlessly
+if (EXISTS "${OUTPUT}")
+    file(READ "${OUTPUT}" EXISTING)
+endif ()
+
+if (NOT "${EXISTING}" STREQUAL "${CONTENT}")
+    file(WRITE "${OUTPUT}" "${CONTENT}")
+endif ()
@@ -0,0 +1,137 @@
+#include "allocation_tracker.hpp"
+
+#include <cstdlib>
+#include <new>
+
+thread_local AllocationTracker::Counters AllocationTracker::threadCounters{};
+
+#if SWEEPMINER_TRACK_ALLOCATIONS
+
+namespace {
+    void* Allocate(const size_t size) {
+        AllocationTracker::recordAllocation(size);
+
+        return std::malloc(size == 0 ? 1 : size);
+    }
+
+    void* AllocateAligned(const size_t size, const std::align_val_t alignment) {
+        AllocationTracker::recordAllocation(size);
+
+        const auto align = static_cast<size_t>(alignment);
+
+#if SWEEPMINER_PLATFORM_WINDOWS
+        return _aligned_malloc(size == 0 ? 1 : size, align);
+#else
+        // aligned_alloc requires the size to be a multiple of the alignment
+        const size_t rounded = (size + align - 1) / align * align;
+
+        return std::aligned_alloc(align, rounded == 0 ? align : rounded);
+#endif
+    }
+
+    void FreeAligned(void* pointer) {
+#if SWEEPMINER_PLATFORM_WINDOWS
+        _aligned_free(pointer);
+#else
+        std::free(pointer);
+#endif
+    }
+}
+
+void* operator new(const size_t size) {
+    if (void* pointer = Allocate(size)) {
+        return pointer;
+    }
+
+    throw std::bad_alloc();
+}
+
+void* operator new[](const size_t size) {
+    if (void* pointer = Allocate(size)) {
+        return pointer;
+    }
+
+    throw std::bad_alloc();
+}
+
+void* operator new(const size_t size, const std::nothrow_t&) noexcept {
+    return Allocate(size);
+}
+
+void* operator new[](const size_t size, const std::nothrow_t&) noexcept {
+    return Allocate(size);
+}
+
+void* operator new(const size_t size, const std::align_val_t alignment) {
+    if (void* pointer = AllocateAligned(size, alignment)) {
+        return pointer;
+    }
+
+    throw std::bad_alloc();
+}
+
+void* operator new[](const size_t size, const std::align_val_t alignment) {
+    if (void* pointer = AllocateAligned(size, alignment)) {
+        return pointer;
+    }
+
+    throw std::bad_alloc();
+}
+
+void* operator new(const size_t size, const std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return AllocateAligned(size, alignment);
+}
+
+void* operator new[](const size_t size, const std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return AllocateAligned(size, alignment);
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, size_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, const std::align_val_t) noexcept {
+    FreeAligned(pointer);
+}
+
+void operator delete[](void* pointer, const std::align_val_t) noexcept {
+    FreeAligned(pointer);
+}
+
+void operator delete(void* pointer, size_t, const std::align_val_t) noexcept {
+    FreeAligned(pointer);
+}
+
+void operator delete[](void* pointer, size_t, const std::align_val_t) noexcept {
+    FreeAligned(pointer);
+}
+
+void operator delete(void* pointer, const std::nothrow_t&) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, const std::align_val_t, const std::nothrow_t&) noexcept {
+    FreeAligned(pointer);
+}
+
+void operator delete[](void* pointer, const std::align_val_t, const std::nothrow_t&) noexcept {
+    FreeAligned(pointer);
+}
+
+#endif
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#ifndef SWEEPMINER_TRACK_ALLOCATIONS
+#define SWEEPMINER_TRACK_ALLOCATIONS 0
+#endif
+
+/**
+ * Counts heap allocations made through the global operator new on the calling thread. The hooks are only compiled in
+ * with the SWEEPMINER_TRACK_ALLOCATIONS CMake option, otherwise every count reads as zero and the profiler skips the
+ * bookkeeping entirely.
+ */
+class AllocationTracker {
+public:
+    static constexpr bool ENABLED = SWEEPMINER_TRACK_ALLOCATIONS;
+
+    struct Counters {
+        uint64_t allocations{0};
+        uint64_t bytes{0};
+    };
+
+    [[nodiscard]] static Counters getThreadCounters() {
+        if constexpr (ENABLED) {
+            return threadCounters;
+        } else {
+            return Counters{};
+        }
+    }
+
+    static void recordAllocation(const size_t bytes) {
+        threadCounters.allocations++;
+        threadCounters.bytes += bytes;
+    }
+
+private:
+    static thread_local Counters threadCounters;
+};
@@ -0,0 +1,131 @@
+#include "asset_pack.hpp"
+
+#include <cstring>
+#include <format>
+#include <stdexcept>
+
+#if SWEEPMINER_PLATFORM_WINDOWS
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+AssetPack::AssetPack(const char* path)
+    : data(nullptr),
+      size(0),
+      header(nullptr),
+      entries(nullptr) {
+#if SWEEPMINER_PLATFORM_WINDOWS
+    this->file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (this->file == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error(std::format("Couldn't open asset pack '{}'", path));
+    }
+
+    LARGE_INTEGER fileSize{};
+    GetFileSizeEx(this->file, &fileSize);
+    this->size = static_cast<size_t>(fileSize.QuadPart);
+
+    this->mapping = CreateFileMappingA(this->file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (this->mapping == nullptr) {
+        CloseHandle(this->file);
+        throw std::runtime_error(std::format("Couldn't map asset pack '{}'", path));
+    }
+
+    this->data = static_cast<const uint8_t*>(MapViewOfFile(this->mapping, FILE_MAP_READ, 0, 0, 0));
+    if (this->data == nullptr) {
+        CloseHandle(this->mapping);
+        CloseHandle(this->file);
+        throw std::runtime_error(std::format("Couldn't map asset pack '{}'", path));
+    }
+#else
+    const int fd = ::open(path, O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error(std::format("Couldn't open asset pack '{}'", path));
+    }
+
+    struct stat info{};
+    if (fstat(fd, &info) != 0) {
+        ::close(fd);
+        throw std::runtime_error(std::format("Couldn't stat asset pack '{}'", path));
+    }
+
+    this->size = static_cast<size_t>(info.st_size);
+
+    // A shared read-only mapping lets every running instance use the same physical pages
+    void* mapped = mmap(nullptr, this->size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+
+    if (mapped == MAP_FAILED) {
+        throw std::runtime_error(std::format("Couldn't map asset pack '{}'", path));
+    }
+
+    this->data = static_cast<const uint8_t*>(mapped);
+#endif
+
+    try {
+        this->validate();
+    } catch (...) {
+        this->unmap();
+        throw;
+    }
+
+    this->header = reinterpret_cast<const Header*>(this->data);
+    this->entries = reinterpret_cast<const Entry*>(this->data + sizeof(Header));
+}
+
+AssetPack::~AssetPack() {
+    this->unmap();
+}
+
+void AssetPack::validate() const {
+    if (this->size < sizeof(Header)) {
+        throw std::runtime_error("Asset pack is truncated");
+    }
+
+    const auto* packHeader = reinterpret_cast<const Header*>(this->data);
+
+    if (std::memcmp(packHeader->magic, MAGIC, sizeof(MAGIC)) != 0) {
+        throw std::runtime_error("Asset pack has an invalid magic number");
+    }
+
+    if (packHeader->version != VERSION) {
+        throw std::runtime_error(std::format("Unsupported asset pack version {}", packHeader->version));
+    }
+
+    if (this->size < sizeof(Header) + packHeader->count * sizeof(Entry)) {
+        throw std::runtime_error("Asset pack entry table is truncated");
+    }
+
+    const auto* packEntries = reinterpret_cast<const Entry*>(this->data + sizeof(Header));
+
+    for (uint32_t i = 0; i < packHeader->count; i++) {
+        if (packEntries[i].offset > this->size || packEntries[i].size > this->size - packEntries[i].offset) {
+            throw std::runtime_error(std::format("Asset pack entry {} is out of bounds", i));
+        }
+    }
+}
+
+void AssetPack::unmap() const {
+#if SWEEPMINER_PLATFORM_WINDOWS
+    UnmapViewOfFile(this->data);
+    CloseHandle(this->mapping);
+    CloseHandle(this->file);
+#else
+    munmap(const_cast<uint8_t*>(this->data), this->size);
+#endif
+}
+
+std::span<const uint8_t> AssetPack::find(const std::string_view path) const {
+    for (uint32_t i = 0; i < this->header->count; i++) {
+        const Entry& entry = this->entries[i];
+
+        if (path == std::string_view(entry.path, strnlen(entry.path, MAX_PATH_LENGTH))) {
+            return {this->data + entry.offset, static_cast<size_t>(entry.size)};
+        }
+    }
+
+    return {};
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+/**
+ * A read-only, memory-mapped archive of every file under assets/. The archive is laid out as a Header, followed by
+ * Header::count Entry records, followed by the raw file contents. All integers are little-endian and every blob starts
+ * on an ALIGNMENT boundary. Archives are produced at build time by tools/asset_packer.cpp.
+ */
+class AssetPack {
+public:
+    static constexpr char MAGIC[4] = {'S', 'W', 'M', 'P'};
+    static constexpr uint32_t VERSION = 1;
+    static constexpr size_t MAX_PATH_LENGTH = 48;
+    static constexpr size_t ALIGNMENT = 16;
+
+    struct Header {
+        char magic[4];
+        uint32_t version;
+        uint32_t count;
+        uint32_t reserved;
+    };
+
+    struct Entry {
+        // Path relative to the repository root (e.g. "assets/images/cell.png"), NUL padded
+        char path[MAX_PATH_LENGTH];
+        uint64_t offset;
+        uint64_t size;
+    };
+
+    static_assert(sizeof(Header) == 16);
+    static_assert(sizeof(Entry) == 64);
+
+    explicit AssetPack(const char* path);
+    ~AssetPack();
+
+    AssetPack(const AssetPack&) = delete;
+    AssetPack& operator=(const AssetPack&) = delete;
+
+    /**
+     * Returns a view of the asset's bytes inside the mapping, or an empty span if the pack doesn't contain it. The
+     * view stays valid for the lifetime of the pack.
+     */
+    [[nodiscard]] std::span<const uint8_t> find(std::string_view path) const;
+
+private:
+    const uint8_t* data;
+    size_t size;
+    const Header* header;
+    const Entry* entries;
+
+#if SWEEPMINER_PLATFORM_WINDOWS
+    void* file;
+    void* mapping;
+#endif
+
+    void validate() const;
+    void unmap() const;
+};
@@ -0,0 +1,48 @@
+#include "assets.hpp"
+
+#include <exception>
+
+#if SWEEPMINER_EMBED_ASSETS
+#include "embedded_assets.hpp"
+#else
+#include "asset_pack.hpp"
+#endif
+
+namespace Assets {
+#if !SWEEPMINER_EMBED_ASSETS
+    static const AssetPack& getPack() {
+        // Mapped on first use; loader threads may race here, which the static initialization guard handles
+        static const AssetPack pack(PACK_PATH);
+
+        return pack;
+    }
+#endif
+
+    SDL_IOStream* open(const char* path) {
+#if SWEEPMINER_EMBED_ASSETS
+        for (const auto& [assetPath, data, size]: EmbeddedAssets::ASSETS) {
+            if (assetPath == path) {
+                return SDL_IOFromConstMem(data, size);
+            }
+        }
+
+        SDL_SetError("No embedded asset named '%s'", path);
+
+        return nullptr;
+#else
+        try {
+            const std::span<const uint8_t> asset = getPack().find(path);
+
+            if (asset.empty()) {
+                SDL_SetError("No asset named '%s' in %s", path, PACK_PATH);
+                return nullptr;
+            }
+
+            return SDL_IOFromConstMem(asset.data(), asset.size());
+        } catch (const std::exception& e) {
+            SDL_SetError("%s", e.what());
+            return nullptr;
+        }
+#endif
+    }
+}
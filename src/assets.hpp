@@ -0,0 +1,18 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+namespace Assets {
+    /**
+     * The asset pack built from assets/ and placed next to the executable, relative to the working directory.
+     */
+    inline constexpr const char* PACK_PATH = "assets.pak";
+
+    /**
+     * Opens the asset at the given path (e.g. "assets/images/cell.png"). When the game is built with
+     * SWEEPMINER_EMBED_ASSETS the asset is served from memory compiled into the executable, otherwise it is served
+     * straight out of the memory-mapped asset pack without copying. Returns nullptr if the asset doesn't exist. The
+     * caller owns the stream.
+     */
+    SDL_IOStream* open(const char* path);
+}
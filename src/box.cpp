@@ -1,5 +1,7 @@
 #include "box.hpp"
 
+#include "render_stats.hpp"
+
 Box::Box(Context* context,
          const SDL_FRect& rect,
          const float borderWidth,
@@ -35,7 +37,7 @@ void Box::render() {
         SDL_Vertex{ .position = SDL_FPoint{ .x = x,     .y = y + h }, .color = secondaryColor },
     };
 
-    SDL_RenderGeometry(renderer, nullptr, borderVertices, 6, nullptr, 0);
+    RenderStats::renderGeometry(renderer, nullptr, borderVertices, 6, nullptr, 0);
 
     if (w > h) {
         const SDL_Vertex cornerFixVertices[6] = {
@@ -47,7 +49,7 @@ void Box::render() {
             SDL_Vertex{ .position = SDL_FPoint{ .x = x + h - b, .y = y + b         }, .color = secondaryColor },
         };
 
-        SDL_RenderGeometry(renderer, nullptr, cornerFixVertices, 6, nullptr, 0);
+        RenderStats::renderGeometry(renderer, nullptr, cornerFixVertices, 6, nullptr, 0);
     }
 
     if (h > w) {
@@ -60,10 +62,10 @@ void Box::render() {
             SDL_Vertex{ .position = SDL_FPoint{ .x = x,         .y = y + h         }, .color = primaryColor },
         };
 
-        SDL_RenderGeometry(renderer, nullptr, cornerFixVertices, 6, nullptr, 0);
+        RenderStats::renderGeometry(renderer, nullptr, cornerFixVertices, 6, nullptr, 0);
     }
 
-    SDL_SetRenderDrawColor(renderer, SpreadColorInt(this->getBackgroundColor()));
+    RenderStats::setDrawColor(renderer, SpreadColorInt(this->getBackgroundColor()));
 
     const SDL_FRect rect = {
         .x = x + b,
@@ -72,5 +74,5 @@ void Box::render() {
         .h = h - b * 2
     };
 
-    SDL_RenderFillRect(renderer, &rect);
+    RenderStats::renderFillRect(renderer, &rect);
 }
@@ -1,16 +1,14 @@
 #include "cell.hpp"
 
-#include "events.hpp"
+#include "render_stats.hpp"
 #include "textures.hpp"
 
-Cell::Cell(Context *context, const SDL_FRect &rect, const uint8_t row, const uint8_t column, const bool containsMine)
+Cell::Cell(Context *context, const SDL_FRect &rect, Board& board, const uint8_t row, const uint8_t column)
     : Box(context, rect, BORDER_WIDTH, WHITE, DARK_GREY, GREY),
       Button(rect),
-      state(State::HIDDEN),
+      board(board),
       row(row),
-      column(column),
-      surroundingMines(0),
-      containsMine(containsMine) {}
+      column(column) {}
 
 Cell::~Cell() = default;
 
@@ -20,7 +18,7 @@ void Cell::render() {
     }
 
     if (this->getState() == State::REVEALED && this->getSurroundingMines() > 0) {
-        SDL_RenderTexture(
+        RenderStats::renderTexture(
             this->getContext().getRenderer(),
             this->getContext().getResourceManager().getTexture(ResourceManager::Texture::CELL),
             TextureOffset::getCountTextureOffset(this->getSurroundingMines()),
@@ -30,7 +28,7 @@ void Cell::render() {
     }
 
     if (this->getState() == State::EXPLODED) {
-        SDL_RenderTexture(
+        RenderStats::renderTexture(
             this->getContext().getRenderer(),
             this->getContext().getResourceManager().getTexture(ResourceManager::Texture::CELL),
             &TextureOffset::MINE_DETONATED,
@@ -40,7 +38,7 @@ void Cell::render() {
     }
 
     if (this->getState() == State::FLAGGED) {
-        SDL_RenderTexture(
+        RenderStats::renderTexture(
             this->getContext().getRenderer(),
             this->getContext().getResourceManager().getTexture(ResourceManager::Texture::CELL),
             &TextureOffset::FLAG,
@@ -50,7 +48,7 @@ void Cell::render() {
     }
 
     if (this->getState() == State::QUESTIONED) {
-        SDL_RenderTexture(
+        RenderStats::renderTexture(
             this->getContext().getRenderer(),
             this->getContext().getResourceManager().getTexture(ResourceManager::Texture::CELL),
             &TextureOffset::QUESTION_MARK,
@@ -79,66 +77,10 @@ void Cell::onMouseDown(const SDL_MouseButtonEvent& event) {
 }
 
 void Cell::onMouseUp(const SDL_MouseButtonEvent& event) {
-    if (this->getState() != State::REVEALED && this->containsMine && event.button == SDL_BUTTON_LEFT) {
-        this->setState(State::EXPLODED);
-
-        MIX_SetTrackAudio(this->getContext().getTrack(), this->getContext().getResourceManager().getSound(ResourceManager::Sound::EXPLODE));
-        MIX_PlayTrack(this->getContext().getTrack(), 0);
-
-        SDL_Event loseGameEvent = Events::CreateSweepMinerEvent(Events::LOSE_GAME, 0);
-        SDL_PushEvent(&loseGameEvent);
-
-        return;
-    }
-
-    if (this->getState() != State::REVEALED && !this->containsMine && event.button == SDL_BUTTON_LEFT) {
-        if (this->getState() == State::FLAGGED) {
-            SDL_Event markChangeEvent = Events::CreateMarkChangeEvent(-1);
-            SDL_PushEvent(&markChangeEvent);
-        }
-
-        this->setState(State::REVEALED);
-
-        MIX_SetTrackAudio(this->getContext().getTrack(), this->getContext().getResourceManager().getSound(ResourceManager::Sound::CLICK));
-        MIX_PlayTrack(this->getContext().getTrack(), 0);
-
-        SDL_Event revealCellEvent = Events::CreateRevealCellEvent(this->row, this->column);
-        SDL_PushEvent(&revealCellEvent);
-
-        return;
-    }
-
-    if (this->getState() == State::HIDDEN && event.button == SDL_BUTTON_RIGHT) {
-        this->setState(State::FLAGGED);
-        SDL_Event markChangeEvent = Events::CreateMarkChangeEvent(1);
-        SDL_PushEvent(&markChangeEvent);
-
-        MIX_SetTrackAudio(this->getContext().getTrack(), this->getContext().getResourceManager().getSound(ResourceManager::Sound::FLAG));
-        MIX_PlayTrack(this->getContext().getTrack(), 0);
-
-        return;
-    }
-
-    if (this->getState() == State::FLAGGED && event.button == SDL_BUTTON_RIGHT) {
-        this->setState(State::QUESTIONED);
-        SDL_Event markChangeEvent = Events::CreateMarkChangeEvent(-1);
-        SDL_PushEvent(&markChangeEvent);
-
-        MIX_SetTrackAudio(this->getContext().getTrack(), this->getContext().getResourceManager().getSound(ResourceManager::Sound::FLAG));
-        MIX_PlayTrack(this->getContext().getTrack(), 0);
-
-        return;
-    }
-
-    if (this->getState() == State::QUESTIONED && event.button == SDL_BUTTON_RIGHT) {
-        this->setState(State::HIDDEN);
-        // TODO: I may still need to emit on HIDDEN but only if Marks (?) are disabled
-        // SDL_Event markChangeEvent = Events::CreateMarkCellEvent(+1);
-        // SDL_PushEvent(&markChangeEvent);
-
-        MIX_SetTrackAudio(this->getContext().getTrack(), this->getContext().getResourceManager().getSound(ResourceManager::Sound::FLAG));
-        MIX_PlayTrack(this->getContext().getTrack(), 0);
-
-        return;
+    // The grid turns the board's events into sounds and SDL events once the click has been handled
+    if (event.button == SDL_BUTTON_LEFT) {
+        this->board.reveal(this->row, this->column);
+    } else if (event.button == SDL_BUTTON_RIGHT) {
+        this->board.cycleMark(this->row, this->column);
     }
 }
@@ -1,31 +1,25 @@
 #pragma once
 
+#include "board.hpp"
 #include "box.hpp"
 #include "button.hpp"
 
+/**
+ * Draws one cell of a Board and forwards clicks on it to the board, which owns the cell's state.
+ */
 class Cell : public Box, public Button {
 public:
     static constexpr float SIZE = 16.0f;
     static constexpr float BORDER_WIDTH = 2.0f;
 
-    enum class State {
-        HIDDEN,
-        FLAGGED,
-        QUESTIONED,
-        REVEALED,
-        EXPLODED,
-    };
+    using State = Board::CellState;
 
-    explicit Cell(Context* context, const SDL_FRect& rect, uint8_t row, uint8_t column, bool containsMine);
+    explicit Cell(Context* context, const SDL_FRect& rect, Board& board, uint8_t row, uint8_t column);
     ~Cell() override;
 
-    [[nodiscard]] State getState() const { return this->state; }
-    void setState(const State newState) { this->state = newState; }
-
-    [[nodiscard]] uint8_t getSurroundingMines() const { return this->surroundingMines; }
-    void setSurroundingMines(const uint8_t mines) { this->surroundingMines = mines; }
-
-    [[nodiscard]] bool hasMine() const { return this->containsMine; }
+    [[nodiscard]] State getState() const { return this->board.getState(this->row, this->column); }
+    [[nodiscard]] uint8_t getSurroundingMines() const { return this->board.getSurroundingMines(this->row, this->column); }
+    [[nodiscard]] bool hasMine() const { return this->board.hasMine(this->row, this->column); }
 
     void render() override;
 
@@ -36,9 +30,7 @@ protected:
     void onMouseUp(const SDL_MouseButtonEvent& event) override;
 
 private:
-    State state;
+    Board& board;
     uint8_t row;
     uint8_t column;
-    uint8_t surroundingMines;
-    bool containsMine;
 };
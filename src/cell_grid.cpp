@@ -1,54 +1,14 @@
 #include "cell_grid.hpp"
 
-#include <array>
-#include <queue>
-#include <random>
-#include <unordered_set>
-
 #include "events.hpp"
+#include "render_stats.hpp"
 #include "util.hpp"
 
-typedef std::pair<int32_t, int32_t> Offset;
-
-constexpr Offset NORTH_WEST = {-1, -1};
-constexpr Offset NORTH      = {+0, -1};
-constexpr Offset NORTH_EAST = {+1, -1};
-constexpr Offset EAST       = {+1, +0};
-constexpr Offset SOUTH_EAST = {+1, +1};
-constexpr Offset SOUTH      = {+0, +1};
-constexpr Offset SOUTH_WEST = {-1, +1};
-constexpr Offset WEST       = {-1, +0};
-
-constexpr std::array EIGHT_DIR_CELL_OFFSETS = {
-    NORTH_WEST, NORTH, NORTH_EAST,
-    WEST,              EAST,
-    SOUTH_WEST, SOUTH, SOUTH_EAST,
-};
-
-constexpr std::array FOUR_DIR_CELL_OFFSETS = {
-    SOUTH,
-    NORTH,
-    WEST,
-    EAST,
-};
-
-CellGrid::CellGrid(Context *context, const SDL_FRect &rect, const uint8_t rows, const uint8_t columns, const uint8_t mines)
+CellGrid::CellGrid(Context *context, const SDL_FRect &rect, std::unique_ptr<Board> board)
     : Box(context, rect, BORDER_WIDTH, DARK_GREY, WHITE, GREY),
-      rows(rows),
-      columns(columns),
-      mines(mines) {
-    const uint16_t totalCells = this->columns * this->rows;
-
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution distribution(0, totalCells - 1);
-
-    uint16_t id = 0;
-    std::unordered_set<uint16_t> mineCells;
-
-    while (mineCells.size() < this->mines) {
-        mineCells.insert(distribution(gen));
-    }
+      board(std::move(board)) {
+    const uint8_t rows = this->getRows();
+    const uint8_t columns = this->getColumns();
 
     for (uint8_t row = 0; row < rows; row++) {
         std::vector<std::unique_ptr<Cell>> cellRow;
@@ -63,36 +23,11 @@ CellGrid::CellGrid(Context *context, const SDL_FRect &rect, const uint8_t rows,
                 .h = Cell::SIZE * context->getScale()
             };
 
-            cellRow.emplace_back(std::make_unique<Cell>(context, cellRect, row, column, mineCells.contains(id)));
-            id++;
+            cellRow.emplace_back(std::make_unique<Cell>(context, cellRect, *this->board, row, column));
         }
 
         this->cells.emplace_back(std::move(cellRow));
     }
-
-    for (uint8_t row = 0; row < this->rows; row++) {
-        for (uint8_t column = 0; column < this->columns; column++) {
-            uint8_t surroundingMineCount = 0;
-
-            for (const auto [deltaColumn, deltaRow]: EIGHT_DIR_CELL_OFFSETS) {
-                const int32_t newRow = row + deltaRow;
-                const int32_t newColumn = column + deltaColumn;
-
-                if (newRow < 0 ||
-                    newRow >= this->rows ||
-                    newColumn < 0 ||
-                    newColumn >= this->columns) {
-                    continue;
-                }
-
-                if (const Cell* cell = this->cells[newRow][newColumn].get(); cell != nullptr && cell->hasMine()) {
-                    surroundingMineCount++;
-                }
-            }
-
-            this->cells[row][column]->setSurroundingMines(surroundingMineCount);
-        }
-    }
 }
 
 CellGrid::~CellGrid() = default;
@@ -105,6 +40,9 @@ std::pair<float, float> CellGrid::getExpectedSize(const float scale, const uint8
 }
 
 void CellGrid::handleEvent(const SDL_Event &event) const {
+    const uint8_t rows = this->getRows();
+    const uint8_t columns = this->getColumns();
+
     switch (event.type) {
         case SDL_EVENT_MOUSE_MOTION:
         case SDL_EVENT_WINDOW_MOUSE_ENTER:
@@ -132,6 +70,8 @@ void CellGrid::handleEvent(const SDL_Event &event) const {
                 if (hit) break;
             }
 
+            this->dispatchBoardEvents();
+
             break;
         }
 
@@ -139,105 +79,80 @@ void CellGrid::handleEvent(const SDL_Event &event) const {
             break;
         }
     }
-
-    if (event.user.type == Events::REVEAL_CELL) {
-        const auto [row, column] = Events::GetRevealedCell(event);
-        this->revealConnectedCells(row, column);
-        this->checkForVictory();
-    }
 }
 
-void CellGrid::revealConnectedCells(const uint8_t selectedCellRow, const uint8_t selectedCellColumn) const {
-    std::queue<std::pair<int8_t, int8_t>> queue{};
-    std::unordered_set<std::pair<int8_t, int8_t>, PairHash> visited{};
-
-    queue.emplace(selectedCellRow, selectedCellColumn);
+void CellGrid::dispatchBoardEvents() const {
+    SoundCoalescer& sounds = this->getContext().getSoundCoalescer();
+    BoardEvent boardEvent{};
 
-    while (!queue.empty()) {
-        const auto [row, column] = queue.front();
-        queue.pop();
+    while (this->board->pollEvent(boardEvent)) {
+        switch (boardEvent.type) {
+            case BoardEvent::Type::CELL_REVEALED: {
+                sounds.trigger(ResourceManager::Sound::CLICK);
 
-        if (column < 0 ||
-            column >= this->getColumns() ||
-            row < 0 ||
-            row >= this->getRows() ||
-            visited.contains({row, column})) {
-            continue;
-        }
-
-        visited.insert({row, column});
-
-        const std::unique_ptr<Cell> &cell = this->cells[row][column];
+                SDL_Event event = Events::CreateRevealCellEvent(boardEvent.row, boardEvent.column);
+                SDL_PushEvent(&event);
 
-        if (cell == nullptr || cell->hasMine()) {
-            continue;
-        }
+                break;
+            }
 
-        if (cell->getState() == Cell::State::FLAGGED) {
-            // this->flags++;
-        }
+            case BoardEvent::Type::CELL_MARKED: {
+                sounds.trigger(ResourceManager::Sound::FLAG);
 
-        if (!(row == selectedCellRow && column == selectedCellColumn)) {
-            if (cell->getState() == Cell::State::FLAGGED) {
-                SDL_Event event = Events::CreateMarkChangeEvent(-1);
-                SDL_PushEvent(&event);
+                break;
             }
 
-            cell->setState(Cell::State::REVEALED);
-        }
+            case BoardEvent::Type::FLAGS_CHANGED: {
+                SDL_Event event = Events::CreateMarkChangeEvent(boardEvent.delta);
+                SDL_PushEvent(&event);
 
-        if (cell->getSurroundingMines() > 0) {
-            continue;
-        }
+                break;
+            }
 
-        for (const auto [deltaRow, deltaColumn]: FOUR_DIR_CELL_OFFSETS) {
-            queue.emplace(row + deltaRow, column + deltaColumn);
-        }
-    }
-}
+            case BoardEvent::Type::MINE_EXPLODED: {
+                sounds.trigger(ResourceManager::Sound::EXPLODE);
 
-void CellGrid::checkForVictory() const {
-    for (uint8_t row = 0; row < this->rows; row++) {
-        for (uint8_t column = 0; column < this->columns; column++) {
-            const Cell* cell = this->cells[row][column].get();
+                SDL_Event event = Events::CreateSweepMinerEvent(Events::LOSE_GAME, 0);
+                SDL_PushEvent(&event);
 
-            if (cell == nullptr) {
-                continue;
+                break;
             }
 
-            if (!cell->hasMine() && cell->getState() != Cell::State::REVEALED) {
-                return;
+            case BoardEvent::Type::VICTORY: {
+                SDL_Event event = Events::CreateSweepMinerEvent(Events::WIN_GAME, 0);
+                SDL_PushEvent(&event);
+
+                break;
             }
         }
     }
-
-    SDL_Event event = Events::CreateSweepMinerEvent(Events::WIN_GAME, 0);
-    SDL_PushEvent(&event);
 }
 
 void CellGrid::render() {
     Box::render();
 
-    SDL_SetRenderDrawColor(this->getContext().getRenderer(), SpreadColorInt(DARK_GREY));
+    RenderStats::setDrawColor(this->getContext().getRenderer(), SpreadColorInt(DARK_GREY));
 
     const float scale = this->getContext().getDisplayScale();
     const float padding = BORDER_WIDTH * scale;
+    const uint8_t rows = this->getRows();
+    const uint8_t columns = this->getColumns();
 
     for (uint8_t i = 0; i < GRID_WIDTH * this->getContext().getDisplayScale(); i++) {
         for (uint8_t row = 0; row < rows; row++) {
-            SDL_RenderLine(this->getContext().getRenderer(),
-                           this->getRect().x + padding,
-                           this->getRect().y + padding + static_cast<float>(row) * Cell::SIZE * scale + static_cast<float>(i),
-                           this->getRect().x + this->getRect().w - padding - 1,
-                           this->getRect().y + padding + static_cast<float>(row) * Cell::SIZE * scale + static_cast<float>(i));
+            RenderStats::renderLine(this->getContext().getRenderer(),
+                                    this->getRect().x + padding,
+                                    this->getRect().y + padding + static_cast<float>(row) * Cell::SIZE * scale + static_cast<float>(i),
+                                    this->getRect().x + this->getRect().w - padding - 1,
+                                    this->getRect().y + padding + static_cast<float>(row) * Cell::SIZE * scale + static_cast<float>(i));
         }
 
         for (uint8_t column = 0; column < columns; column++) {
-            SDL_RenderLine(this->getContext().getRenderer(),
-                           this->getRect().x + padding + static_cast<float>(column) * Cell::SIZE * scale + static_cast<float>(i),
-                           this->getRect().y + padding,
-                           this->getRect().x + padding + static_cast<float>(column) * Cell::SIZE * scale + static_cast<float>(i),
-                           this->getRect().y + this->getRect().h - padding - 1);
+            RenderStats::renderLine(this->getContext().getRenderer(),
+                                    this->getRect().x + padding + static_cast<float>(column) * Cell::SIZE * scale + static_cast<float>(i),
+                                    this->getRect().y + padding,
+                                    this->getRect().x + padding + static_cast<float>(column) * Cell::SIZE * scale + static_cast<float>(i),
+                                    this->getRect().y + this->getRect().h - padding - 1);
         }
     }
 
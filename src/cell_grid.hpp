@@ -3,6 +3,7 @@
 #include <memory>
 #include <utility>
 
+#include "board.hpp"
 #include "box.hpp"
 #include "cell.hpp"
 
@@ -11,24 +12,27 @@ public:
     static constexpr float BORDER_WIDTH = 3.0f;
     static constexpr uint8_t GRID_WIDTH = 1;
 
-    explicit CellGrid(Context* context, const SDL_FRect& rect, uint8_t rows, uint8_t columns, uint8_t mines);
+    explicit CellGrid(Context* context, const SDL_FRect& rect, std::unique_ptr<Board> board);
     ~CellGrid() override;
 
     void render() override;
 
     [[nodiscard]] static std::pair<float, float> getExpectedSize(float scale, uint8_t rows, uint8_t columns);
 
-    [[nodiscard]] uint8_t getRows() const { return this->rows; }
-    [[nodiscard]] uint8_t getColumns() const { return this->columns; }
-    [[nodiscard]] uint8_t getMines() const { return this->mines; }
+    [[nodiscard]] uint8_t getRows() const { return this->board->getRows(); }
+    [[nodiscard]] uint8_t getColumns() const { return this->board->getColumns(); }
+    [[nodiscard]] uint8_t getMines() const { return this->board->getMines(); }
+    [[nodiscard]] Board& getBoard() const { return *this->board; }
 
     void handleEvent(const SDL_Event &event) const;
-    void revealConnectedCells(uint8_t selectedCellRow, uint8_t selectedCellColumn) const;
-    void checkForVictory() const;
 
 private:
-    uint8_t rows;
-    uint8_t columns;
-    uint8_t mines;
+    // Cells keep a reference to the board, so it lives on the heap where moving the grid can't invalidate it
+    std::unique_ptr<Board> board;
     std::vector<std::vector<std::unique_ptr<Cell>>> cells;
+
+    /**
+     * Plays the sounds for and pushes the SDL events of everything that happened on the board since the last call.
+     */
+    void dispatchBoardEvents() const;
 };
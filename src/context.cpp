@@ -4,21 +4,22 @@ Context::Context(SDL_Window* window,
                  SDL_Renderer* renderer,
                  TTF_TextEngine* textEngine,
                  MIX_Mixer* mixer,
-                 MIX_Track* track,
                  const float scale,
                  const float displayScale)
     : window(window),
       renderer(renderer),
       textEngine(textEngine),
       mixer(mixer),
-      track(track),
       scale(scale),
       displayScale(displayScale) {
     this->resourceManager = std::make_unique<ResourceManager>(window, renderer, mixer);
+    this->voicePool = std::make_unique<VoicePool>(mixer);
+    this->soundCoalescer = std::make_unique<SoundCoalescer>(this->voicePool.get());
 }
 
 Context::~Context() {
-    MIX_DestroyTrack(track);
+    this->soundCoalescer.reset();
+    this->voicePool.reset();
     MIX_DestroyMixer(mixer);
     TTF_DestroyRendererTextEngine(textEngine);
     SDL_DestroyRenderer(renderer);
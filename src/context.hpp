@@ -7,6 +7,8 @@
 #include <SDL3_ttf/SDL_ttf.h>
 
 #include "resource_manager.hpp"
+#include "sound_coalescer.hpp"
+#include "voice_pool.hpp"
 
 class Context {
 public:
@@ -14,7 +16,6 @@ public:
                      SDL_Renderer* renderer,
                      TTF_TextEngine* textEngine,
                      MIX_Mixer* mixer,
-                     MIX_Track* track,
                      float scale,
                      float displayScale);
     ~Context();
@@ -26,9 +27,10 @@ public:
     [[nodiscard]] SDL_Renderer* getRenderer() const { return this->renderer; }
     [[nodiscard]] TTF_TextEngine* getTextEngine() const { return this->textEngine; }
     [[nodiscard]] MIX_Mixer* getMixer() const { return this->mixer; }
-    [[nodiscard]] MIX_Track* getTrack() const { return this->track; }
 
     [[nodiscard]] ResourceManager& getResourceManager() const { return *this->resourceManager; }
+    [[nodiscard]] VoicePool& getVoicePool() const { return *this->voicePool; }
+    [[nodiscard]] SoundCoalescer& getSoundCoalescer() const { return *this->soundCoalescer; }
     [[nodiscard]] float getScale() const { return this->scale; }
     [[nodiscard]] float getDisplayScale() const { return this->displayScale; }
 
@@ -37,8 +39,9 @@ private:
     SDL_Renderer *renderer;
     TTF_TextEngine *textEngine;
     MIX_Mixer *mixer;
-    MIX_Track *track;
     std::unique_ptr<ResourceManager> resourceManager;
+    std::unique_ptr<VoicePool> voicePool;
+    std::unique_ptr<SoundCoalescer> soundCoalescer;
     float scale;
     float displayScale;
 };
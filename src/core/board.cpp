@@ -0,0 +1,276 @@
+#include "board.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+#include "board_generation.hpp"
+#include "board_kernels.hpp"
+
+Board::Board(const uint8_t rows, const uint8_t columns, const uint8_t mines, std::mt19937& generator)
+    : Board(PlaceMines(rows, columns, mines, generator)) {}
+
+Board::Board(const uint8_t rows, const uint8_t columns, const std::vector<uint8_t>& mineCells)
+    : Board(PaddedGrid<uint8_t>::fromRowMajor(rows, columns, mineCells, 0)) {}
+
+Board::Board(PaddedGrid<uint8_t> mineCells)
+    : rows(mineCells.getRows()),
+      columns(mineCells.getColumns()),
+      mines(static_cast<uint8_t>(
+          std::count_if(mineCells.data(), mineCells.data() + mineCells.size(), [](const uint8_t mine) { return mine != 0; }))),
+      mineCells(std::move(mineCells)),
+      surroundingMines(CountSurroundingMines(this->mineCells)),
+      states(this->rows, this->columns, CellState::HIDDEN) {
+    this->surroundingMines.fillBorder(BORDER_SURROUNDING_MINES);
+    this->states.fillBorder(CellState::REVEALED);
+}
+
+void Board::reveal(const uint8_t row, const uint8_t column) {
+    CellState& state = this->states[this->getIndex(row, column)];
+
+    if (state == CellState::REVEALED) {
+        return;
+    }
+
+    if (this->hasMine(row, column)) {
+        state = CellState::EXPLODED;
+        this->push(BoardEvent::Type::MINE_EXPLODED, row, column);
+
+        return;
+    }
+
+    if (state == CellState::FLAGGED) {
+        this->push(BoardEvent::Type::FLAGS_CHANGED, row, column, -1);
+    }
+
+    state = CellState::REVEALED;
+    this->push(BoardEvent::Type::CELL_REVEALED, row, column);
+
+    this->revealConnectedCells(row, column);
+    this->checkForVictory();
+}
+
+void Board::cycleMark(const uint8_t row, const uint8_t column) {
+    CellState& state = this->states[this->getIndex(row, column)];
+
+    switch (state) {
+        case CellState::HIDDEN:
+            state = CellState::FLAGGED;
+            this->push(BoardEvent::Type::FLAGS_CHANGED, row, column, 1);
+            break;
+        case CellState::FLAGGED:
+            state = CellState::QUESTIONED;
+            this->push(BoardEvent::Type::FLAGS_CHANGED, row, column, -1);
+            break;
+        case CellState::QUESTIONED:
+            // TODO: Going back to hidden may need to count as a flag change once Marks (?) can be disabled
+            state = CellState::HIDDEN;
+            break;
+        default:
+            return;
+    }
+
+    this->push(BoardEvent::Type::CELL_MARKED, row, column);
+}
+
+void Board::revealConnectedCells(const uint8_t selectedCellRow, const uint8_t selectedCellColumn) {
+    if (DispatchStandardBoard(this->rows, this->columns, [&]<typename Dimensions>(Dimensions) {
+        this->revealConnectedCellsFixed<Dimensions>(selectedCellRow, selectedCellColumn);
+    })) {
+        return;
+    }
+
+    const auto stride = static_cast<ptrdiff_t>(this->states.getStride());
+    const std::array<ptrdiff_t, 4> offsets = {stride, -stride, -1, 1};
+
+    const size_t selected = this->getIndex(selectedCellRow, selectedCellColumn);
+
+    // Cells are marked visited as they are queued, so each one is queued at most once
+    const auto visit = [this](const size_t index) {
+        if (this->floodVisited[index] == 0) {
+            this->floodVisited[index] = 1;
+            this->floodQueue.push_back(static_cast<uint32_t>(index));
+        }
+    };
+
+    this->floodVisited.resize(this->states.size(), 0);
+    this->floodQueue.clear();
+
+    visit(selected);
+
+    for (size_t head = 0; head < this->floodQueue.size(); head++) {
+        const size_t index = this->floodQueue[head];
+
+        if (this->mineCells[index] != 0) {
+            continue;
+        }
+
+        if (index != selected) {
+            CellState& state = this->states[index];
+
+            if (state == CellState::FLAGGED) {
+                this->push(BoardEvent::Type::FLAGS_CHANGED, this->states.getRow(index), this->states.getColumn(index), -1);
+            }
+
+            state = CellState::REVEALED;
+        }
+
+        // Also true for the border, which is as far as the fill ever gets past the edge
+        if (this->surroundingMines[index] > 0) {
+            continue;
+        }
+
+        // South, north, west and east, the order the events have always come out in
+        for (const ptrdiff_t offset: offsets) {
+            visit(static_cast<size_t>(static_cast<ptrdiff_t>(index) + offset));
+        }
+    }
+
+    for (const uint32_t index: this->floodQueue) {
+        this->floodVisited[index] = 0;
+    }
+}
+
+bool Board::checkForVictory() {
+    bool cleared = true;
+
+    if (!DispatchStandardBoard(this->rows, this->columns, [&]<typename Dimensions>(Dimensions) {
+        cleared = this->isClearedFixed<Dimensions>();
+    })) {
+        // The border rows above and below the board are left out, the border columns never count as hidden
+        const size_t stride = this->states.getStride();
+
+        for (size_t i = stride; i < this->states.size() - stride; i++) {
+            if (this->mineCells[i] == 0 && this->states[i] != CellState::REVEALED) {
+                cleared = false;
+                break;
+            }
+        }
+    }
+
+    if (!cleared) {
+        return false;
+    }
+
+    this->push(BoardEvent::Type::VICTORY, 0, 0);
+
+    return true;
+}
+
+bool Board::pollEvent(BoardEvent& event) {
+    if (this->nextEvent == this->events.size()) {
+        // Keeps the capacity so steady state play doesn't allocate
+        this->events.clear();
+        this->nextEvent = 0;
+
+        return false;
+    }
+
+    event = this->events[this->nextEvent++];
+
+    return true;
+}
+
+void Board::push(const BoardEvent::Type type, const uint8_t row, const uint8_t column, const int8_t delta) {
+    if (type == BoardEvent::Type::FLAGS_CHANGED) {
+        this->flags = static_cast<uint16_t>(this->flags + delta);
+    }
+
+    this->events.push_back(BoardEvent{.type = type, .row = row, .column = column, .delta = delta});
+}
+
+template <typename Dimensions>
+void Board::revealConnectedCellsFixed(const uint8_t selectedCellRow, const uint8_t selectedCellColumn) {
+    constexpr size_t STRIDE = Dimensions::STRIDE;
+
+    // Cells are marked visited as they are queued, so each one is queued at most once and the queue can't overflow
+    std::array<uint16_t, Dimensions::PADDED_CELLS> queue;
+    std::array<bool, Dimensions::PADDED_CELLS> visited{};
+    size_t head = 0;
+    size_t tail = 0;
+
+    const auto selected = static_cast<uint16_t>(this->getIndex(selectedCellRow, selectedCellColumn));
+
+    const auto visit = [&](const size_t index) {
+        if (!visited[index]) {
+            visited[index] = true;
+            queue[tail++] = static_cast<uint16_t>(index);
+        }
+    };
+
+    visit(selected);
+
+    while (head < tail) {
+        const size_t index = queue[head++];
+
+        if (this->mineCells[index] != 0) {
+            continue;
+        }
+
+        if (index != selected) {
+            CellState& state = this->states[index];
+
+            if (state == CellState::FLAGGED) {
+                this->push(
+                    BoardEvent::Type::FLAGS_CHANGED,
+                    static_cast<uint8_t>(index / STRIDE - 1),
+                    static_cast<uint8_t>(index % STRIDE - 1),
+                    -1);
+            }
+
+            state = CellState::REVEALED;
+        }
+
+        if (this->surroundingMines[index] > 0) {
+            continue;
+        }
+
+        // The same order as the generic walk, so events come out as they do there
+        visit(index + STRIDE);
+        visit(index - STRIDE);
+        visit(index - 1);
+        visit(index + 1);
+    }
+}
+
+template <typename Dimensions>
+bool Board::isClearedFixed() const {
+    // Most checks happen mid game and stop at an early hidden cell, so the scan tests eight cells at a time as one
+    // word, branching once per word rather than once per cell. It runs from the first to the last row of the board,
+    // border columns included, since the border never counts as hidden.
+    constexpr size_t WORD = sizeof(uint64_t);
+    constexpr size_t FIRST = Dimensions::STRIDE;
+    constexpr size_t END = Dimensions::PADDED_CELLS - Dimensions::STRIDE;
+    constexpr size_t WORDS_END = FIRST + (END - FIRST) / WORD * WORD;
+    constexpr uint64_t LOW_BITS = 0x0101010101010101;
+    constexpr uint64_t REVEALED = LOW_BITS * static_cast<uint8_t>(CellState::REVEALED);
+
+    static_assert(static_cast<uint8_t>(CellState::EXPLODED) < 8, "every CellState has to fit in three bits");
+
+    const uint8_t* mines = this->mineCells.data();
+    const auto* cellStates = reinterpret_cast<const uint8_t*>(this->states.data());
+
+    for (size_t start = FIRST; start < WORDS_END; start += WORD) {
+        uint64_t mineWord;
+        uint64_t stateWord;
+
+        std::memcpy(&mineWord, mines + start, WORD);
+        std::memcpy(&stateWord, cellStates + start, WORD);
+
+        // The low bit of every byte is set where the state isn't REVEALED and then cleared where there's a mine
+        const uint64_t difference = stateWord ^ REVEALED;
+        const uint64_t notRevealed = (difference | difference >> 1 | difference >> 2) & LOW_BITS;
+
+        if ((notRevealed & ~mineWord) != 0) {
+            return false;
+        }
+    }
+
+    for (size_t i = WORDS_END; i < END; i++) {
+        if (mines[i] == 0 && cellStates[i] != static_cast<uint8_t>(CellState::REVEALED)) {
+            return false;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "board_event.hpp"
+#include "padded_grid.hpp"
+
+/**
+ * The rules of the game without any presentation: where the mines are, which cells the player has revealed or marked,
+ * and when the game is won or lost. Nothing here depends on SDL, so boards can be built and played headless.
+ *
+ * Actions don't call back into the caller, they queue BoardEvents that the owner drains with pollEvent.
+ *
+ * Cells are kept in PaddedGrids whose border reads as a revealed, numbered cell without a mine, so flood fills stop at
+ * the edge of the board without bounds checks and victory checks never find anything left to reveal there.
+ */
+class Board {
+public:
+    enum class CellState : uint8_t {
+        HIDDEN,
+        FLAGGED,
+        QUESTIONED,
+        REVEALED,
+        EXPLODED,
+    };
+
+    explicit Board(uint8_t rows, uint8_t columns, uint8_t mines, std::mt19937& generator);
+
+    /**
+     * Builds a board with a fixed layout, mineCells holds 1 for every mined cell in row major order.
+     */
+    explicit Board(uint8_t rows, uint8_t columns, const std::vector<uint8_t>& mineCells);
+
+    /**
+     * Builds a board with a fixed layout as made by PlaceMines.
+     */
+    explicit Board(PaddedGrid<uint8_t> mineCells);
+
+    [[nodiscard]] uint8_t getRows() const { return this->rows; }
+    [[nodiscard]] uint8_t getColumns() const { return this->columns; }
+    [[nodiscard]] uint8_t getMines() const { return this->mines; }
+    [[nodiscard]] uint16_t getFlags() const { return this->flags; }
+
+    [[nodiscard]] CellState getState(const uint8_t row, const uint8_t column) const {
+        return this->states[this->getIndex(row, column)];
+    }
+
+    [[nodiscard]] bool hasMine(const uint8_t row, const uint8_t column) const {
+        return this->mineCells[this->getIndex(row, column)] != 0;
+    }
+
+    [[nodiscard]] uint8_t getSurroundingMines(const uint8_t row, const uint8_t column) const {
+        return this->surroundingMines[this->getIndex(row, column)];
+    }
+
+    /**
+     * Reveals a cell as a left click does. Revealing a mine loses the game, revealing an empty cell also reveals the
+     * empty area around it and then checks for victory.
+     */
+    void reveal(uint8_t row, uint8_t column);
+
+    /**
+     * Cycles a hidden cell's mark as a right click does, from hidden to flagged to questioned and back to hidden.
+     */
+    void cycleMark(uint8_t row, uint8_t column);
+
+    /**
+     * Reveals every cell reachable from the given one through cells without surrounding mines, stopping at the first
+     * numbered cell in each direction. The given cell itself is left as it is.
+     */
+    void revealConnectedCells(uint8_t selectedCellRow, uint8_t selectedCellColumn);
+
+    /**
+     * Queues a VICTORY event and returns true when every cell without a mine has been revealed.
+     */
+    bool checkForVictory();
+
+    /**
+     * Takes the oldest queued event. Returns false once the queue is empty.
+     */
+    bool pollEvent(BoardEvent& event);
+
+private:
+    /**
+     * Never a real count, which tops out at 8.
+     */
+    static constexpr uint8_t BORDER_SURROUNDING_MINES = 9;
+
+    uint8_t rows;
+    uint8_t columns;
+    uint8_t mines;
+    uint16_t flags{0};
+    PaddedGrid<uint8_t> mineCells;
+    PaddedGrid<uint8_t> surroundingMines;
+    PaddedGrid<CellState> states;
+    std::vector<BoardEvent> events{};
+    size_t nextEvent{0};
+
+    // Scratch space of the generic flood fill, kept between calls so revealing doesn't allocate once it has grown
+    std::vector<uint32_t> floodQueue{};
+    std::vector<uint8_t> floodVisited{};
+
+    [[nodiscard]] size_t getIndex(const uint8_t row, const uint8_t column) const {
+        return this->states.getIndex(row, column);
+    }
+
+    void push(BoardEvent::Type type, uint8_t row, uint8_t column, int8_t delta = 0);
+
+    /**
+     * revealConnectedCells and the victory check for the standard board sizes, see board_kernels.hpp.
+     */
+    template <typename Dimensions>
+    void revealConnectedCellsFixed(uint8_t selectedCellRow, uint8_t selectedCellColumn);
+
+    template <typename Dimensions>
+    [[nodiscard]] bool isClearedFixed() const;
+};
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * Something that happened on a Board that the presentation layer may want to react to, with a sound, an SDL event or
+ * an update of the flag counter.
+ */
+struct BoardEvent {
+    enum class Type {
+        /**
+         * The player revealed a cell without a mine.
+         */
+        CELL_REVEALED,
+
+        /**
+         * The player cycled the mark on a hidden cell.
+         */
+        CELL_MARKED,
+
+        /**
+         * The number of flagged cells changed by delta, either by the player or because a reveal uncovered flags.
+         */
+        FLAGS_CHANGED,
+
+        MINE_EXPLODED,
+        VICTORY,
+    };
+
+    Type type;
+    uint8_t row;
+    uint8_t column;
+    int8_t delta;
+};
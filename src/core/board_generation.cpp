@@ -0,0 +1,60 @@
+#include "board_generation.hpp"
+
+#include "board_kernels.hpp"
+
+PaddedGrid<uint8_t> PlaceMines(const uint8_t rows, const uint8_t columns, const uint8_t mines, std::mt19937& generator) {
+    PaddedGrid<uint8_t> board(rows, columns, 0);
+
+    if (DispatchStandardBoard(rows, columns, [&]<typename Dimensions>(Dimensions) {
+        PlaceMinesFixed<Dimensions>(mines, generator, board.data());
+    })) {
+        return board;
+    }
+
+    const uint16_t totalCells = columns * rows;
+
+    std::uniform_int_distribution distribution(0, totalCells - 1);
+
+    // Drawing a cell that already holds a mine changes nothing, so the board doubles as the set of taken cells
+    for (uint16_t placed = 0; placed < mines;) {
+        const int cell = distribution(generator);
+        uint8_t& mine = board[board.getIndex(static_cast<uint8_t>(cell / columns), static_cast<uint8_t>(cell % columns))];
+
+        placed += mine ^ 1;
+        mine = 1;
+    }
+
+    return board;
+}
+
+PaddedGrid<uint8_t> CountSurroundingMines(const PaddedGrid<uint8_t>& mines) {
+    const uint8_t rows = mines.getRows();
+    const uint8_t columns = mines.getColumns();
+
+    PaddedGrid<uint8_t> counts(rows, columns, 0);
+
+    if (DispatchStandardBoard(rows, columns, [&]<typename Dimensions>(Dimensions) {
+        CountSurroundingMinesFixed<Dimensions>(mines.data(), counts.data());
+    })) {
+        return counts;
+    }
+
+    const auto offsets = mines.getNeighbourOffsets();
+    const uint8_t* cells = mines.data();
+
+    for (uint8_t row = 0; row < rows; row++) {
+        const size_t first = mines.getIndex(row, 0);
+
+        for (size_t index = first; index < first + columns; index++) {
+            uint8_t surroundingMineCount = 0;
+
+            for (const ptrdiff_t offset: offsets) {
+                surroundingMineCount += cells[static_cast<ptrdiff_t>(index) + offset];
+            }
+
+            counts[index] = surroundingMineCount;
+        }
+    }
+
+    return counts;
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstdint>
+#include <random>
+
+#include "padded_grid.hpp"
+
+/**
+ * Picks the given number of distinct cells of a rows by columns board to hold mines. The result holds 1 for every
+ * mined cell and 0 everywhere else, border included.
+ */
+PaddedGrid<uint8_t> PlaceMines(uint8_t rows, uint8_t columns, uint8_t mines, std::mt19937& generator);
+
+/**
+ * Counts the mines in the eight neighbours of every cell of a board laid out as by PlaceMines. The border of the
+ * result is 0.
+ */
+PaddedGrid<uint8_t> CountSurroundingMines(const PaddedGrid<uint8_t>& mines);
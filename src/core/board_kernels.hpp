@@ -0,0 +1,101 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+/**
+ * The size of a board as compile time constants, so kernels specialised on it get fixed loop bounds, constant strides
+ * and storage that fits on the stack. STRIDE and PADDED_CELLS describe the same board stored in a PaddedGrid.
+ */
+template <uint8_t Rows, uint8_t Columns>
+struct BoardDimensions {
+    static constexpr uint8_t ROWS = Rows;
+    static constexpr uint8_t COLUMNS = Columns;
+    static constexpr size_t CELLS = static_cast<size_t>(Rows) * Columns;
+    static constexpr size_t STRIDE = static_cast<size_t>(Columns) + 2;
+    static constexpr size_t PADDED_CELLS = (static_cast<size_t>(Rows) + 2) * STRIDE;
+};
+
+using BeginnerDimensions = BoardDimensions<9, 9>;
+using IntermediateDimensions = BoardDimensions<16, 16>;
+using ExpertDimensions = BoardDimensions<16, 30>;
+
+/**
+ * Calls body with the BoardDimensions of the standard difficulty matching the given size. Returns false without
+ * calling it for any other size, which is left to the generic code.
+ */
+template <typename Body>
+bool DispatchStandardBoard(const uint8_t rows, const uint8_t columns, Body&& body) {
+    if (rows == BeginnerDimensions::ROWS && columns == BeginnerDimensions::COLUMNS) {
+        body(BeginnerDimensions{});
+        return true;
+    }
+
+    if (rows == IntermediateDimensions::ROWS && columns == IntermediateDimensions::COLUMNS) {
+        body(IntermediateDimensions{});
+        return true;
+    }
+
+    if (rows == ExpertDimensions::ROWS && columns == ExpertDimensions::COLUMNS) {
+        body(ExpertDimensions{});
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ * PlaceMines for a fixed size, into the interior of a zeroed PaddedGrid. The board itself remembers which cells are
+ * taken, so it draws the same cells from the generator as the generic version and produces the same layout for the
+ * same seed.
+ */
+template <typename Dimensions>
+void PlaceMinesFixed(const uint8_t mines, std::mt19937& generator, uint8_t* board) {
+    std::uniform_int_distribution distribution(0, static_cast<int>(Dimensions::CELLS) - 1);
+
+    for (uint8_t placed = 0; placed < mines;) {
+        const auto cell = static_cast<size_t>(distribution(generator));
+        uint8_t& mine = board[(cell / Dimensions::COLUMNS + 1) * Dimensions::STRIDE + cell % Dimensions::COLUMNS + 1];
+
+        placed += mine ^ 1;
+        mine = 1;
+    }
+}
+
+/**
+ * CountSurroundingMines for a fixed size, from and into PaddedGrid storage. Sums every cell's row of three first and
+ * then adds up the rows above and below, so each cell costs a handful of adds. The zeroed border stands in for the
+ * cells off the edge of the board, so edge cells need no special cases.
+ */
+template <typename Dimensions>
+void CountSurroundingMinesFixed(const uint8_t* mines, uint8_t* counts) {
+    constexpr size_t ROWS = Dimensions::ROWS;
+    constexpr size_t COLUMNS = Dimensions::COLUMNS;
+    constexpr size_t STRIDE = Dimensions::STRIDE;
+
+    // The border rows of rowSums stay zero
+    std::array<uint8_t, Dimensions::PADDED_CELLS> rowSums{};
+
+    for (size_t row = 1; row <= ROWS; row++) {
+        const uint8_t* cells = mines + row * STRIDE;
+        uint8_t* sums = rowSums.data() + row * STRIDE;
+
+        for (size_t column = 1; column <= COLUMNS; column++) {
+            sums[column] = static_cast<uint8_t>(cells[column - 1] + cells[column] + cells[column + 1]);
+        }
+    }
+
+    for (size_t row = 1; row <= ROWS; row++) {
+        const uint8_t* above = rowSums.data() + (row - 1) * STRIDE;
+        const uint8_t* sums = rowSums.data() + row * STRIDE;
+        const uint8_t* below = rowSums.data() + (row + 1) * STRIDE;
+        const uint8_t* cells = mines + row * STRIDE;
+        uint8_t* rowCounts = counts + row * STRIDE;
+
+        for (size_t column = 1; column <= COLUMNS; column++) {
+            rowCounts[column] = static_cast<uint8_t>(above[column] + sums[column] + below[column] - cells[column]);
+        }
+    }
+}
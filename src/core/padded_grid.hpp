@@ -0,0 +1,108 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Row major storage for one value per cell with a one cell border of sentinels around the board. Every cell,
+ * including those on the edges, has all eight neighbours at the same fixed index offsets, so walking neighbours needs
+ * no bounds checks, the border just has to hold values the walk treats as a dead end.
+ */
+template <typename T>
+class PaddedGrid {
+public:
+    explicit PaddedGrid(const uint8_t rows, const uint8_t columns, const T border)
+        : rows(rows),
+          columns(columns),
+          stride(static_cast<size_t>(columns) + 2),
+          cells((static_cast<size_t>(rows) + 2) * this->stride, border) {}
+
+    /**
+     * Copies a board laid out in row major order without a border into the interior.
+     */
+    static PaddedGrid fromRowMajor(const uint8_t rows, const uint8_t columns, const std::vector<T>& values, const T border) {
+        PaddedGrid grid(rows, columns, border);
+
+        for (uint8_t row = 0; row < rows; row++) {
+            for (uint8_t column = 0; column < columns; column++) {
+                grid[grid.getIndex(row, column)] = values[static_cast<size_t>(row) * columns + column];
+            }
+        }
+
+        return grid;
+    }
+
+    [[nodiscard]] uint8_t getRows() const { return this->rows; }
+    [[nodiscard]] uint8_t getColumns() const { return this->columns; }
+
+    /**
+     * The distance between vertically adjacent cells.
+     */
+    [[nodiscard]] size_t getStride() const { return this->stride; }
+
+    /**
+     * The number of stored values, border included.
+     */
+    [[nodiscard]] size_t size() const { return this->cells.size(); }
+
+    [[nodiscard]] size_t getIndex(const uint8_t row, const uint8_t column) const {
+        return (static_cast<size_t>(row) + 1) * this->stride + column + 1;
+    }
+
+    [[nodiscard]] uint8_t getRow(const size_t index) const { return static_cast<uint8_t>(index / this->stride - 1); }
+    [[nodiscard]] uint8_t getColumn(const size_t index) const { return static_cast<uint8_t>(index % this->stride - 1); }
+
+    /**
+     * The index offsets of the eight neighbours of any cell, row by row from the top left.
+     */
+    [[nodiscard]] std::array<ptrdiff_t, 8> getNeighbourOffsets() const {
+        const auto stride = static_cast<ptrdiff_t>(this->stride);
+
+        return {-stride - 1, -stride, -stride + 1, -1, 1, stride - 1, stride, stride + 1};
+    }
+
+    /**
+     * Sets every border value, leaving the interior as it is.
+     */
+    void fillBorder(const T border) {
+        const size_t last = this->cells.size() - this->stride;
+
+        for (size_t column = 0; column < this->stride; column++) {
+            this->cells[column] = border;
+            this->cells[last + column] = border;
+        }
+
+        for (size_t index = this->stride; index < last; index += this->stride) {
+            this->cells[index] = border;
+            this->cells[index + this->stride - 1] = border;
+        }
+    }
+
+    [[nodiscard]] std::vector<T> toRowMajor() const {
+        std::vector<T> values;
+
+        values.reserve(static_cast<size_t>(this->rows) * this->columns);
+
+        for (uint8_t row = 0; row < this->rows; row++) {
+            for (uint8_t column = 0; column < this->columns; column++) {
+                values.push_back(this->cells[this->getIndex(row, column)]);
+            }
+        }
+
+        return values;
+    }
+
+    T& operator[](const size_t index) { return this->cells[index]; }
+    const T& operator[](const size_t index) const { return this->cells[index]; }
+
+    T* data() { return this->cells.data(); }
+    const T* data() const { return this->cells.data(); }
+
+private:
+    uint8_t rows;
+    uint8_t columns;
+    size_t stride;
+    std::vector<T> cells;
+};
@@ -1,5 +1,6 @@
 #include "counter.hpp"
 
+#include "render_stats.hpp"
 #include "textures.hpp"
 
 Counter::Counter(Context *context, const SDL_FRect &rect)
@@ -13,6 +14,7 @@ void Counter::render() {
     const auto [x, y, w, h] = this->getRect();
 
     const std::array<uint8_t, 3> digits = this->getDigits();
+    SDL_Texture* numbers = this->getContext().getResourceManager().getTexture(ResourceManager::Texture::NUMBERS);
 
     for (size_t i = 0; i < digits.size(); i++) {
         SDL_FRect dest{
@@ -22,9 +24,9 @@ void Counter::render() {
             .h = SEGMENT_HEIGHT * this->getContext().getDisplayScale(),
         };
 
-        SDL_RenderTexture(
+        RenderStats::renderTexture(
             this->getContext().getRenderer(),
-            this->getContext().getResourceManager().getTexture(ResourceManager::Texture::NUMBERS),
+            numbers,
             TextureOffset::getNumberTextureOffset(digits.at(i)),
             &dest);
     }
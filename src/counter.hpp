@@ -17,6 +17,7 @@ public:
 
     void increment() { this->value++; }
     void decrement() { this->value--; }
+    void setValue(const uint16_t newValue) { this->value = newValue; }
 
     [[nodiscard]] uint16_t getValue() const { return this->value; }
 
@@ -1,48 +1,57 @@
 #include "game.hpp"
 
-#include <chrono>
-
 #include "box.hpp"
 #include "util.hpp"
 #include "events.hpp"
 #include "profiler.hpp"
 #include "menu_bar.hpp"
+#include "startup_tracer.hpp"
 
-Game::Game(SDL_Window* window, SDL_Renderer* renderer, TTF_TextEngine* textEngine, MIX_Mixer* mixer, MIX_Track* track, const float menuBarHeight)
-    : context(std::make_unique<Context>(window, renderer, textEngine, mixer, track, SCALE, SDL_GetWindowDisplayScale(window))),
-      menuBarHeight(menuBarHeight) {
-    this->timer = std::make_unique<Timer>([this] { this->scoreBoard->tick(); }, 1000);
-}
+Game::Game(SDL_Window* window, SDL_Renderer* renderer, TTF_TextEngine* textEngine, MIX_Mixer* mixer, const float menuBarHeight)
+    : context(std::make_unique<Context>(window, renderer, textEngine, mixer, SCALE, SDL_GetWindowDisplayScale(window))),
+      menuBarHeight(menuBarHeight),
+      clock(std::make_unique<GameClock>()) {}
 
 Game::~Game() = default;
 
 void Game::init() {
+    StartupTracer& tracer = StartupTracer::getInstance();
     ResourceManager& manager = this->getContext().getResourceManager();
 
-    manager.loadTexture(ResourceManager::Texture::CELL, "assets/images/cell.png");
-    manager.loadTexture(ResourceManager::Texture::NUMBERS, "assets/images/numbers.png");
-    manager.loadTexture(ResourceManager::Texture::SMILEY, "assets/images/smiley.png");
+    tracer.begin("Queue Assets");
+
+    // Sounds keep decoding in the background and are handed to the voice pool as they arrive, the first frame only
+    // needs the textures
+    manager.setSoundLoadedCallback([this](const ResourceManager::Sound sound, MIX_Audio* audio) {
+        this->getContext().getVoicePool().setAudio(sound, audio);
+    });
+
+    manager.queueTexture(ResourceManager::Texture::CELL, "assets/images/cell.png");
+    manager.queueTexture(ResourceManager::Texture::NUMBERS, "assets/images/numbers.png");
+    manager.queueTexture(ResourceManager::Texture::SMILEY, "assets/images/smiley.png");
 
-    manager.loadSound(ResourceManager::Sound::CLICK, "assets/sounds/click.wav");
-    manager.loadSound(ResourceManager::Sound::FLAG, "assets/sounds/flag.wav");
-    manager.loadSound(ResourceManager::Sound::EXPLODE, "assets/sounds/explode.wav");
+    manager.queueSound(ResourceManager::Sound::CLICK, "assets/sounds/click.wav");
+    manager.queueSound(ResourceManager::Sound::FLAG, "assets/sounds/flag.wav");
+    manager.queueSound(ResourceManager::Sound::EXPLODE, "assets/sounds/explode.wav");
+    tracer.end();
 
+    tracer.begin("Load Font");
     manager.loadFont(ResourceManager::Font::SOURCE_CODE_PRO, "assets/fonts/SourceCodePro-Medium.ttf", Profiler::FONT_SIZE);
+    tracer.end();
+
+    tracer.begin("Wait For Textures");
+    manager.waitForTextures();
+    tracer.end();
 
+    tracer.begin("New Game");
     this->newGame();
+    tracer.end();
 
     SDL_SetWindowPosition(this->getContext().getWindow(), SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED);
 }
 
 // TODO: Maybe I should make this private or handle it all in the constructor and use SDL_Event's everywhere instead
 void Game::newGame() {
-    this->timer->stop();
-    this->background.reset();
-    this->scoreBoard.reset();
-    this->cellGrid.reset();
-
-    this->setState(State::NEW);
-
     uint8_t rows{0};
     uint8_t columns{0};
     uint8_t mines{0};
@@ -67,6 +76,20 @@ void Game::newGame() {
             std::unreachable();
     }
 
+    this->newGame(std::make_unique<Board>(rows, columns, mines, this->generator));
+}
+
+void Game::newGame(std::unique_ptr<Board> board) {
+    this->clock->reset();
+    this->background.reset();
+    this->scoreBoard.reset();
+    this->cellGrid.reset();
+
+    this->setState(State::NEW);
+
+    const uint8_t rows = board->getRows();
+    const uint8_t columns = board->getColumns();
+
     const auto [cellGridWidth, cellGridHeight] = CellGrid::getExpectedSize(this->getContext().getScale(), rows, columns);
 
     const SDL_FRect backgroundRect{
@@ -90,7 +113,7 @@ void Game::newGame() {
 
     this->background = std::make_unique<Box>(this->context.get(), backgroundRect, BORDER_WIDTH, WHITE, DARK_GREY, GREY);
     this->scoreBoard = std::make_unique<ScoreBoard>(this->context.get(), scoreBoardRect);
-    this->cellGrid = std::make_unique<CellGrid>(this->context.get(), cellGridRect, rows, columns, mines);
+    this->cellGrid = std::make_unique<CellGrid>(this->context.get(), cellGridRect, std::move(board));
 
     SDL_SetWindowSize(
         this->getContext().getWindow(),
@@ -99,14 +122,14 @@ void Game::newGame() {
 }
 
 void Game::endGame(const Game::State endState) {
-    this->timer->stop();
+    this->clock->stop();
     this->setState(endState);
 }
 
 void Game::start() {
     if (this->getState() == State::NEW) {
         this->setState(State::RUNNING);
-        this->timer->start();
+        this->clock->start();
     } else {
         SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Attempted to start game that is not in NEW state");
     }
@@ -133,13 +156,17 @@ void Game::handleEvent(const SDL_Event &event) {
 }
 
 void Game::render(const double deltaTime) const {
+    this->getContext().getResourceManager().update();
+
+    this->scoreBoard->setTime(this->clock->getDisplaySeconds());
+
     ProfileCall("Background Render", this->background->render());
     ProfileCall("Score Board Render", this->scoreBoard->render());
     ProfileCall("Cell Grid Render", this->cellGrid->render());
 
-#if SWEEPMINER_ENABLE_PROFILER
-    ProfileCall("Profiler Render", Profiler::getInstance().render(deltaTime));
-#endif
+    if (Profiler::isEnabled()) {
+        ProfileCall("Profiler Render", Profiler::getInstance().render(deltaTime));
+    }
 }
 
 #undef ProfileCall
@@ -1,13 +1,14 @@
 #pragma once
 
 #include <memory>
+#include <random>
 
 #include "box.hpp"
 #include "cell_grid.hpp"
 #include "context.hpp"
+#include "game_clock.hpp"
 #include "profiler.hpp"
 #include "score_board.hpp"
-#include "timer.hpp"
 
 class Game {
 public:
@@ -24,10 +25,13 @@ public:
         EXPERT
     };
 
-    explicit Game(SDL_Window* window, SDL_Renderer* renderer, TTF_TextEngine* textEngine, MIX_Mixer* mixer, MIX_Track* track, float menuBarHeight);
+    explicit Game(SDL_Window* window, SDL_Renderer* renderer, TTF_TextEngine* textEngine, MIX_Mixer* mixer, float menuBarHeight);
     ~Game();
 
     [[nodiscard]] Context& getContext() const { return *this->context; }
+    [[nodiscard]] const GameClock& getClock() const { return *this->clock; }
+    [[nodiscard]] ScoreBoard& getScoreBoard() const { return *this->scoreBoard; }
+    [[nodiscard]] CellGrid& getCellGrid() const { return *this->cellGrid; }
 
     [[nodiscard]] State getState() const { return this->state; }
     void setState(const State newState) { this->state = newState; }
@@ -37,6 +41,11 @@ public:
 
     void init();
     void newGame();
+
+    /**
+     * Starts a new game on the given board instead of a random one of the current difficulty.
+     */
+    void newGame(std::unique_ptr<Board> board);
     void endGame(State endState);
     void start();
 
@@ -56,5 +65,6 @@ private:
     std::unique_ptr<Box> background;
     std::unique_ptr<ScoreBoard> scoreBoard;
     std::unique_ptr<CellGrid> cellGrid;
-    std::unique_ptr<Timer> timer;
+    std::unique_ptr<GameClock> clock;
+    std::mt19937 generator{std::random_device{}()};
 };
@@ -0,0 +1,98 @@
+#include "game_clock.hpp"
+
+#include <algorithm>
+
+#include <SDL3/SDL.h>
+
+GameClock::GameClock()
+    : state(State::IDLE),
+      frequency(SDL_GetPerformanceFrequency()),
+      startCounter(0),
+      pauseCounter(0),
+      endCounter(0),
+      pausedTicks(0) {}
+
+GameClock::~GameClock() = default;
+
+void GameClock::start() {
+    if (this->state != State::IDLE) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Attempted to start game clock that is not idle");
+        return;
+    }
+
+    this->startCounter = SDL_GetPerformanceCounter();
+    this->state = State::RUNNING;
+}
+
+void GameClock::pause() {
+    if (this->state != State::RUNNING) {
+        return;
+    }
+
+    this->pauseCounter = SDL_GetPerformanceCounter();
+    this->state = State::PAUSED;
+}
+
+void GameClock::resume() {
+    if (this->state != State::PAUSED) {
+        return;
+    }
+
+    this->pausedTicks += SDL_GetPerformanceCounter() - this->pauseCounter;
+    this->state = State::RUNNING;
+}
+
+void GameClock::stop() {
+    if (this->state == State::PAUSED) {
+        this->resume();
+    }
+
+    if (this->state != State::RUNNING) {
+        return;
+    }
+
+    this->endCounter = SDL_GetPerformanceCounter();
+    this->state = State::STOPPED;
+}
+
+void GameClock::reset() {
+    this->state = State::IDLE;
+    this->startCounter = 0;
+    this->pauseCounter = 0;
+    this->endCounter = 0;
+    this->pausedTicks = 0;
+}
+
+uint64_t GameClock::getElapsedTicks() const {
+    switch (this->state) {
+        case State::RUNNING:
+            return SDL_GetPerformanceCounter() - this->startCounter - this->pausedTicks;
+        case State::PAUSED:
+            return this->pauseCounter - this->startCounter - this->pausedTicks;
+        case State::STOPPED:
+            return this->endCounter - this->startCounter - this->pausedTicks;
+        default:
+            return 0;
+    }
+}
+
+uint64_t GameClock::getElapsedMicroseconds() const {
+    const uint64_t ticks = this->getElapsedTicks();
+
+    // Split the conversion so long sessions on high frequency counters can't overflow the multiplication
+    return ticks / this->frequency * 1'000'000 + ticks % this->frequency * 1'000'000 / this->frequency;
+}
+
+double GameClock::getElapsedSeconds() const {
+    return static_cast<double>(this->getElapsedMicroseconds()) / 1'000'000.0;
+}
+
+uint16_t GameClock::getDisplaySeconds() const {
+    if (this->state == State::IDLE) {
+        return 0;
+    }
+
+    const uint64_t seconds = this->getElapsedMicroseconds() / 1'000'000 + 1;
+
+    return static_cast<uint16_t>(std::min<uint64_t>(seconds, MAX_DISPLAY_SECONDS));
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+
+class GameClock {
+public:
+    static constexpr uint16_t MAX_DISPLAY_SECONDS = 999;
+
+    enum class State {
+        IDLE,
+        RUNNING,
+        PAUSED,
+        STOPPED,
+    };
+
+    GameClock();
+    ~GameClock();
+
+    void start();
+    void pause();
+    void resume();
+    void stop();
+    void reset();
+
+    [[nodiscard]] State getState() const { return this->state; }
+
+    /**
+     * The time spent in the RUNNING state, in microseconds. Paused time is excluded and the value is frozen once the
+     * clock is stopped.
+     */
+    [[nodiscard]] uint64_t getElapsedMicroseconds() const;
+    [[nodiscard]] double getElapsedSeconds() const;
+
+    /**
+     * The value shown on the 3-digit score board counter. Like the classic game, the counter reads 1 as soon as the
+     * clock starts and is capped at 999.
+     */
+    [[nodiscard]] uint16_t getDisplaySeconds() const;
+
+    [[nodiscard]] uint64_t getStartCounter() const { return this->startCounter; }
+    [[nodiscard]] uint64_t getEndCounter() const { return this->endCounter; }
+
+private:
+    State state;
+    uint64_t frequency;
+    uint64_t startCounter;
+    uint64_t pauseCounter;
+    uint64_t endCounter;
+    uint64_t pausedTicks;
+
+    [[nodiscard]] uint64_t getElapsedTicks() const;
+};
@@ -0,0 +1,82 @@
+#include "histogram.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+void Histogram::record(const uint64_t value) {
+    this->counts[getBucket(value)]++;
+    this->count++;
+    this->max = std::max(this->max, value);
+}
+
+void Histogram::merge(const Histogram& other) {
+    for (size_t i = 0; i < BUCKET_COUNT; i++) {
+        this->counts[i] += other.counts[i];
+    }
+
+    this->count += other.count;
+    this->max = std::max(this->max, other.max);
+}
+
+void Histogram::clear() {
+    this->counts.fill(0);
+    this->count = 0;
+    this->max = 0;
+}
+
+uint64_t Histogram::getPercentile(const double percentile) const {
+    if (this->count == 0) {
+        return 0;
+    }
+
+    const auto target = std::max<uint64_t>(
+        1,
+        static_cast<uint64_t>(std::ceil(percentile / 100.0 * static_cast<double>(this->count))));
+
+    uint64_t seen = 0;
+
+    for (size_t i = 0; i < BUCKET_COUNT; i++) {
+        seen += this->counts[i];
+
+        // The last bucket also holds everything past the covered range, only the largest value bounds it
+        if (seen >= target) {
+            return i == BUCKET_COUNT - 1 ? this->max : std::min(getBucketUpperBound(i), this->max);
+        }
+    }
+
+    return this->max;
+}
+
+size_t Histogram::getBucket(const uint64_t value) {
+    // Values below SUB_BUCKET_COUNT are exact, every power of two above that gets SUB_BUCKET_COUNT buckets
+    if (value < SUB_BUCKET_COUNT) {
+        return static_cast<size_t>(value);
+    }
+
+    const size_t exponent = std::bit_width(value) - 1;
+    const size_t shift = exponent - SUB_BUCKET_BITS;
+    const size_t magnitude = shift + 1;
+
+    if (magnitude >= MAGNITUDE_COUNT) {
+        return BUCKET_COUNT - 1;
+    }
+
+    const size_t subBucket = static_cast<size_t>(value >> shift) & (SUB_BUCKET_COUNT - 1);
+
+    return magnitude * SUB_BUCKET_COUNT + subBucket;
+}
+
+uint64_t Histogram::getBucketUpperBound(const size_t bucket) {
+    const size_t magnitude = bucket / SUB_BUCKET_COUNT;
+    const size_t subBucket = bucket % SUB_BUCKET_COUNT;
+
+    if (magnitude == 0) {
+        return subBucket;
+    }
+
+    const size_t shift = magnitude - 1;
+    const uint64_t lower = static_cast<uint64_t>(SUB_BUCKET_COUNT + subBucket) << shift;
+
+    return lower + (uint64_t{1} << shift) - 1;
+}
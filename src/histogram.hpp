@@ -0,0 +1,40 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * A fixed size log-linear histogram in the style of HdrHistogram. Every power of two range is split into
+ * SUB_BUCKET_COUNT linear buckets, so values are kept with a relative error of at most 1 / SUB_BUCKET_COUNT, under
+ * 0.8%, and recording never allocates. Values below SUB_BUCKET_COUNT are exact, values from 2^34 up, over 17 s in
+ * nanoseconds, all land in the last bucket.
+ */
+class Histogram {
+public:
+    static constexpr size_t SUB_BUCKET_BITS = 7;
+    static constexpr size_t SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS;
+    static constexpr size_t MAGNITUDE_COUNT = 28;
+    static constexpr size_t BUCKET_COUNT = MAGNITUDE_COUNT * SUB_BUCKET_COUNT;
+
+    void record(uint64_t value);
+    void merge(const Histogram& other);
+    void clear();
+
+    [[nodiscard]] uint64_t getCount() const { return this->count; }
+    [[nodiscard]] uint64_t getMax() const { return this->max; }
+
+    /**
+     * The smallest recorded value that the given percentage of samples are at or below, reported as the upper bound of
+     * its bucket and clamped to the largest recorded value.
+     */
+    [[nodiscard]] uint64_t getPercentile(double percentile) const;
+
+private:
+    std::array<uint32_t, BUCKET_COUNT> counts{};
+    uint64_t count{0};
+    uint64_t max{0};
+
+    static size_t getBucket(uint64_t value);
+    static uint64_t getBucketUpperBound(size_t bucket);
+};
@@ -0,0 +1,247 @@
+#include "input_bench.hpp"
+
+#include <algorithm>
+#include <format>
+
+#include "board_generation.hpp"
+#include "metrics_csv.hpp"
+
+const std::array<InputBench::Scenario, 6> InputBench::SCENARIOS = {{
+    {.name = "expert.motion_sweep", .rows = 16, .columns = 30, .mines = 99, .pattern = Pattern::MOTION_SWEEP},
+    {.name = "expert.click_storm", .rows = 16, .columns = 30, .mines = 99, .pattern = Pattern::CLICK_STORM},
+    {.name = "expert.flag_cycling", .rows = 16, .columns = 30, .mines = 99, .pattern = Pattern::FLAG_CYCLING},
+    {.name = "custom_64x64.motion_sweep", .rows = 64, .columns = 64, .mines = 255, .pattern = Pattern::MOTION_SWEEP},
+    {.name = "custom_64x64.click_storm", .rows = 64, .columns = 64, .mines = 255, .pattern = Pattern::CLICK_STORM},
+    {.name = "custom_64x64.flag_cycling", .rows = 64, .columns = 64, .mines = 255, .pattern = Pattern::FLAG_CYCLING},
+}};
+
+InputBench::InputBench(Game& game, const uint64_t events) : game(game), events(events) {}
+
+bool InputBench::run(const EventCallback& appEvent, const std::string& csvPath) {
+    constexpr std::array<std::pair<Target, const char*>, 3> TARGETS = {{
+        {Target::APP, "app"},
+        {Target::SCORE_BOARD, "score_board"},
+        {Target::CELL_GRID, "cell_grid"},
+    }};
+
+    std::vector<Result> results;
+
+    results.reserve(SCENARIOS.size() * TARGETS.size());
+
+    SDL_Log("Input bench: %" SDL_PRIu64 " events per scenario", this->events);
+
+    for (const Scenario& scenario: SCENARIOS) {
+        const std::vector<uint8_t> mineCells =
+            PlaceMines(scenario.rows, scenario.columns, scenario.mines, this->generator).toRowMajor();
+
+        // The pattern is laid out on the grid of the scenario's first game, every later game has the same geometry
+        this->startGame(scenario, mineCells);
+
+        const std::vector<SDL_Event> pattern = this->createPattern(scenario.pattern, mineCells);
+
+        for (const auto& [target, targetName]: TARGETS) {
+            const std::string name = std::format("{}.{}", scenario.name, targetName);
+            const Result& result =
+                results.emplace_back(this->runTarget(name, target, scenario, mineCells, pattern, appEvent));
+
+            SDL_Log("%-40s %10.0f events/s  p50 %8.3f us  p99 %8.3f us  max %9.3f us  %" SDL_PRIu64 " dispatched",
+                    result.name.c_str(),
+                    static_cast<double>(result.events) / result.seconds,
+                    static_cast<double>(result.latencies.getPercentile(50.0)) / 1000.0,
+                    static_cast<double>(result.latencies.getPercentile(99.0)) / 1000.0,
+                    static_cast<double>(result.latencies.getMax()) / 1000.0,
+                    result.latencies.getCount());
+        }
+    }
+
+    // Nothing the bench pushed is left for the main loop to handle
+    SDL_FlushEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST);
+
+    return csvPath.empty() || writeCsv(csvPath, results);
+}
+
+InputBench::Result InputBench::runTarget(
+    const std::string& name,
+    const Target target,
+    const Scenario& scenario,
+    const std::vector<uint8_t>& mineCells,
+    const std::vector<SDL_Event>& pattern,
+    const EventCallback& appEvent) {
+    const uint64_t frequency = SDL_GetPerformanceFrequency();
+
+    Result result{.name = name, .events = 0, .seconds = 0.0, .latencies = {}};
+    uint64_t elapsed = 0;
+    size_t position = 0;
+
+    const auto dispatch = [&](SDL_Event& event) {
+        const uint64_t start = SDL_GetPerformanceCounter();
+
+        switch (target) {
+            case Target::APP:
+                appEvent(event);
+                break;
+            case Target::SCORE_BOARD:
+                this->game.getScoreBoard().handleEvent(event);
+                break;
+            case Target::CELL_GRID:
+                this->game.getCellGrid().handleEvent(event);
+                break;
+        }
+
+        result.latencies.record((SDL_GetPerformanceCounter() - start) * 1'000'000'000 / frequency);
+    };
+
+    this->startGame(scenario, mineCells);
+
+    while (result.events < this->events) {
+        if (position == pattern.size()) {
+            this->startGame(scenario, mineCells);
+            position = 0;
+        }
+
+        const size_t count = std::min({BATCH_SIZE, pattern.size() - position, this->events - result.events});
+        const uint64_t start = SDL_GetPerformanceCounter();
+
+        if (target == Target::APP) {
+            // Pushed in batches that stay well below SDL's queue limit, then drained with the events the game pushed
+            for (size_t i = 0; i < count; i++) {
+                SDL_Event event = pattern[position + i];
+                SDL_PushEvent(&event);
+            }
+
+            SDL_Event event;
+
+            while (SDL_PollEvent(&event)) {
+                dispatch(event);
+            }
+        } else {
+            for (size_t i = 0; i < count; i++) {
+                SDL_Event event = pattern[position + i];
+                dispatch(event);
+            }
+        }
+
+        elapsed += SDL_GetPerformanceCounter() - start;
+
+        if (target != Target::APP) {
+            // Nobody handles the reveal and mark events the grid pushed when it's driven directly
+            SDL_FlushEvents(SDL_EVENT_USER, SDL_EVENT_LAST);
+        }
+
+        position += count;
+        result.events += count;
+    }
+
+    result.seconds = static_cast<double>(elapsed) / static_cast<double>(frequency);
+
+    return result;
+}
+
+void InputBench::startGame(const Scenario& scenario, const std::vector<uint8_t>& mineCells) const {
+    this->game.newGame(std::make_unique<Board>(scenario.rows, scenario.columns, mineCells));
+}
+
+std::vector<SDL_Event> InputBench::createPattern(const Pattern pattern, const std::vector<uint8_t>& mineCells) const {
+    const CellGrid& grid = this->game.getCellGrid();
+    const uint8_t rows = grid.getRows();
+    const uint8_t columns = grid.getColumns();
+    const float cellSize = Cell::SIZE * this->game.getContext().getScale();
+
+    // Cells hit-test against their layout rectangle, which is what mouse coordinates are in
+    const auto getCenter = [&](const uint8_t row, const uint8_t column) {
+        return SDL_FPoint{
+            .x = grid.getBounds().x + CellGrid::BORDER_WIDTH + (static_cast<float>(column) + 0.5f) * cellSize,
+            .y = grid.getBounds().y + CellGrid::BORDER_WIDTH + (static_cast<float>(row) + 0.5f) * cellSize,
+        };
+    };
+
+    const auto pushClick = [](std::vector<SDL_Event>& events, const SDL_FPoint point, const uint8_t button) {
+        for (const bool down: {true, false}) {
+            SDL_Event event{};
+
+            event.button.type = down ? SDL_EVENT_MOUSE_BUTTON_DOWN : SDL_EVENT_MOUSE_BUTTON_UP;
+            event.button.button = button;
+            event.button.down = down;
+            event.button.clicks = 1;
+            event.button.x = point.x;
+            event.button.y = point.y;
+
+            events.push_back(event);
+        }
+    };
+
+    std::vector<SDL_Event> events;
+
+    switch (pattern) {
+        case Pattern::MOTION_SWEEP: {
+            SDL_FPoint previous = getCenter(0, 0);
+
+            // Back and forth along every row, so each event moves the pointer onto a neighbouring cell
+            for (uint8_t row = 0; row < rows; row++) {
+                for (uint8_t step = 0; step < columns; step++) {
+                    const auto column = static_cast<uint8_t>(row % 2 == 0 ? step : columns - 1 - step);
+                    const SDL_FPoint point = getCenter(row, column);
+
+                    SDL_Event event{};
+
+                    event.motion.type = SDL_EVENT_MOUSE_MOTION;
+                    event.motion.x = point.x;
+                    event.motion.y = point.y;
+                    event.motion.xrel = point.x - previous.x;
+                    event.motion.yrel = point.y - previous.y;
+
+                    events.push_back(event);
+                    previous = point;
+                }
+            }
+
+            break;
+        }
+
+        case Pattern::CLICK_STORM: {
+            // Mines are skipped so every pass plays the game through to victory instead of ending at the first mine
+            for (uint8_t row = 0; row < rows; row++) {
+                for (uint8_t column = 0; column < columns; column++) {
+                    if (mineCells[static_cast<size_t>(row) * columns + column] == 0) {
+                        pushClick(events, getCenter(row, column), SDL_BUTTON_LEFT);
+                    }
+                }
+            }
+
+            break;
+        }
+
+        case Pattern::FLAG_CYCLING: {
+            // Flagged, questioned and hidden again
+            for (uint8_t row = 0; row < rows; row++) {
+                for (uint8_t column = 0; column < columns; column++) {
+                    for (int i = 0; i < 3; i++) {
+                        pushClick(events, getCenter(row, column), SDL_BUTTON_RIGHT);
+                    }
+                }
+            }
+
+            break;
+        }
+    }
+
+    return events;
+}
+
+bool InputBench::writeCsv(const std::string& path, const std::vector<Result>& results) {
+    MetricsCsv csv;
+
+    const auto append = [&csv](const std::string& name, const char* metric, const double value) {
+        csv.append(0.0, std::format("input_bench.{}.{}", name, metric), value);
+    };
+
+    // Everything is written as a cost so sweepminer_metrics_compare reads larger values as regressions
+    for (const Result& result: results) {
+        append(result.name, "mean_ns", result.seconds * 1'000'000'000.0 / static_cast<double>(result.events));
+        append(result.name, "p50_ns", static_cast<double>(result.latencies.getPercentile(50.0)));
+        append(result.name, "p99_ns", static_cast<double>(result.latencies.getPercentile(99.0)));
+        append(result.name, "max_ns", static_cast<double>(result.latencies.getMax()));
+    }
+
+    return csv.save(path);
+}
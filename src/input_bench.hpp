@@ -0,0 +1,93 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <SDL3/SDL.h>
+
+#include "game.hpp"
+#include "histogram.hpp"
+
+/**
+ * Injects synthetic input into a headless game and reports events per second and the latency of every event. Each
+ * scenario repeats one pattern of input, mouse motion sweeping over every cell, a storm of left clicks on every cell
+ * without a mine, or right clicks cycling every cell through its marks, starting a fresh game on the same board every
+ * time the pattern wraps.
+ *
+ * Every scenario is measured three ways: pushed with SDL_PushEvent and dispatched through SDL_AppEvent like real
+ * input, including the events the game pushes in response, and handed straight to ScoreBoard::handleEvent and to
+ * CellGrid::handleEvent.
+ */
+class InputBench {
+public:
+    struct Result {
+        std::string name;
+        uint64_t events;
+        double seconds;
+        Histogram latencies;
+    };
+
+    /**
+     * Dispatches one event exactly as SDL_AppEvent does.
+     */
+    using EventCallback = std::function<SDL_AppResult(SDL_Event&)>;
+
+    explicit InputBench(Game& game, uint64_t events);
+
+    /**
+     * Runs every scenario, logs a report and writes it as metrics CSV when a path is given. Returns false if the CSV
+     * couldn't be written.
+     */
+    bool run(const EventCallback& appEvent, const std::string& csvPath);
+
+private:
+    static constexpr size_t BATCH_SIZE = 1024;
+    static constexpr uint32_t SEED = 0x5eed;
+
+    enum class Pattern {
+        MOTION_SWEEP,
+        CLICK_STORM,
+        FLAG_CYCLING,
+    };
+
+    enum class Target {
+        APP,
+        SCORE_BOARD,
+        CELL_GRID,
+    };
+
+    struct Scenario {
+        const char* name;
+        uint8_t rows;
+        uint8_t columns;
+        uint8_t mines;
+        Pattern pattern;
+    };
+
+    static const std::array<Scenario, 6> SCENARIOS;
+
+    Game& game;
+    uint64_t events;
+    std::mt19937 generator{SEED};
+
+    Result runTarget(
+        const std::string& name,
+        Target target,
+        const Scenario& scenario,
+        const std::vector<uint8_t>& mineCells,
+        const std::vector<SDL_Event>& pattern,
+        const EventCallback& appEvent);
+
+    void startGame(const Scenario& scenario, const std::vector<uint8_t>& mineCells) const;
+
+    /**
+     * The input of one pass over the current game's grid.
+     */
+    [[nodiscard]] std::vector<SDL_Event> createPattern(Pattern pattern, const std::vector<uint8_t>& mineCells) const;
+
+    static bool writeCsv(const std::string& path, const std::vector<Result>& results);
+};
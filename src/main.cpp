@@ -11,18 +11,29 @@
 #include "game.hpp"
 #include "util.hpp"
 #include "profiler.hpp"
+#include "allocation_tracker.hpp"
+#include "input_bench.hpp"
+#include "memory_bench.hpp"
 #include "menu_bar.hpp"
-
-#define UNUSED(x) (void)(x)
+#include "metrics_sink.hpp"
+#include "options.hpp"
+#include "render_bench.hpp"
+#include "render_stats.hpp"
+#include "startup_tracer.hpp"
 
 struct AppState {
+    Options options{};
     uint64_t lastCounter{};
+    uint64_t frameCount{};
     double deltaTime{};
     std::unique_ptr<Game> game{};
     std::unique_ptr<IMenuBar> menuBar{};
     std::unique_ptr<Profiler> profiler{};
+    std::unique_ptr<MetricsSink> metrics{};
 };
 
+constexpr uint64_t ALLOCATION_BUDGET_WARMUP_FRAMES = 60;
+
 enum Menu {
     ID_APP_MENU = 100,
     ID_APP_ABOUT,
@@ -69,39 +80,68 @@ void SDL_DestroyAll(SDL_Window* window = nullptr,
 }
 
 SDL_AppResult SDL_AppInit(void** appstate, const int argc, char* argv[]) {
-    UNUSED(argc);
-    UNUSED(argv);
+    StartupTracer& tracer = StartupTracer::getInstance();
 
     *appstate = nullptr;
 
     SDL_SetLogPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_DEBUG);
     SDL_SetAppMetadata("com.ahmic.sweepminer", "SweepMiner", "1.0.0");
 
+    Options options = ParseOptions(argc, argv);
+
+    Profiler::setThreadName("Main");
+
+    if (options.profiler) {
+        Profiler::setEnabled(true);
+    }
+
+    if (options.frameAllocationBudget && !AllocationTracker::ENABLED) {
+        SDL_LogWarn(
+            SDL_LOG_CATEGORY_APPLICATION,
+            "Ignoring --frame-alloc-budget, allocations are only counted with SWEEPMINER_TRACK_ALLOCATIONS");
+    }
+
+    if (options.isHeadlessBench()) {
+        // Only defaults, the environment variables still pick another driver to bench
+        SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "offscreen");
+        SDL_SetHint(SDL_HINT_RENDER_DRIVER, "software");
+        SDL_SetHint(SDL_HINT_AUDIO_DRIVER, "dummy");
+    }
+
+    tracer.begin("SDL Init");
     if (!SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO)) {
         SDL_QuitAll();
 
         return SDL_Fail("Couldn't initialize SDL");
     }
+    tracer.end();
 
+    tracer.begin("TTF Init");
     if (!TTF_Init()) {
         SDL_QuitAll();
 
         return SDL_Fail("Couldn't initialize SDL_ttf");
     }
+    tracer.end();
 
+    tracer.begin("Mixer Init");
     if (!MIX_Init()) {
         SDL_QuitAll();
 
         return SDL_Fail("Couldn't initialize SDL_mixer");
     }
+    tracer.end();
 
+    tracer.begin("Create Window");
     SDL_Window* window = SDL_CreateWindow("SweepMiner", 200, 200, SDL_WINDOW_HIGH_PIXEL_DENSITY);
     if (!window) {
         SDL_QuitAll();
 
         return SDL_Fail("Couldn't create window");
     }
+    tracer.end();
 
+    tracer.begin("Create Renderer");
     SDL_Renderer* renderer = SDL_CreateRenderer(window, nullptr);
     if (!renderer) {
         SDL_DestroyAll(window);
@@ -109,7 +149,9 @@ SDL_AppResult SDL_AppInit(void** appstate, const int argc, char* argv[]) {
 
         return SDL_Fail("Couldn't create renderer");
     }
+    tracer.end();
 
+    tracer.begin("Create Text Engine");
     TTF_TextEngine* textEngine = TTF_CreateRendererTextEngine(renderer);
     if (!textEngine) {
         SDL_DestroyAll(window, renderer);
@@ -117,7 +159,9 @@ SDL_AppResult SDL_AppInit(void** appstate, const int argc, char* argv[]) {
 
         return SDL_Fail("Couldn't create text engine");
     }
+    tracer.end();
 
+    tracer.begin("Create Mixer");
     MIX_Mixer* mixer = MIX_CreateMixerDevice(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, nullptr);
     if (!mixer) {
         SDL_DestroyAll(window, renderer, textEngine);
@@ -125,24 +169,24 @@ SDL_AppResult SDL_AppInit(void** appstate, const int argc, char* argv[]) {
 
         return SDL_Fail("Couldn't create mixer");
     }
-
-    MIX_Track* track = MIX_CreateTrack(mixer);
-    if (!track) {
-        SDL_DestroyAll(window, renderer, textEngine, mixer);
-        SDL_QuitAll();
-
-        return SDL_Fail("Couldn't create track");
-    }
+    tracer.end();
 
     SDL_Log("Renderer: %s", SDL_GetRendererName(renderer));
 
-    SDL_SetRenderVSync(renderer, 1);
+    tracer.begin("Show Window");
+    SDL_SetRenderVSync(renderer, options.isHeadlessBench() ? 0 : 1);
     SDL_ShowWindow(window);
+    tracer.end();
 
+    tracer.begin("Events Init");
     Events::init();
+    tracer.end();
 
+    tracer.begin("Create Menu Bar");
     std::unique_ptr<IMenuBar> menuBar = CreateMenuBar(window, Events::MENU_CLICK);
+    tracer.end();
 
+    tracer.begin("Build Menus");
 #ifdef SWEEPMINER_PLATFORM_MACOS
     menuBar->addMenu(ID_APP_MENU, "SweepMiner");
     menuBar->addItem(ID_APP_ABOUT, ID_APP_MENU, "About");
@@ -178,26 +222,38 @@ SDL_AppResult SDL_AppInit(void** appstate, const int argc, char* argv[]) {
 #endif
     menuBar->addItem(ID_HELP_GITHUB, ID_HELP_MENU, "GitHub");
     menuBar->addItem(ID_HELP_REPORT_ISSUE, ID_HELP_MENU, "Report an Issue");
+    tracer.end();
 
     try {
-        auto game = std::make_unique<Game>(window, renderer, textEngine, mixer, track, menuBar->getHeight());
+        tracer.begin("Create Game");
+        auto game = std::make_unique<Game>(window, renderer, textEngine, mixer, menuBar->getHeight());
+        tracer.end();
 
+        tracer.begin("Game Init");
         game->init();
+        tracer.end();
 
-#if SWEEPMINER_ENABLE_PROFILER
-        auto profiler = std::make_unique<Profiler>(renderer, textEngine);
-#endif
+        tracer.begin("Create Profiler");
+        auto profiler = std::make_unique<Profiler>(
+            renderer,
+            textEngine,
+            game->getContext().getResourceManager().getFont(ResourceManager::Font::SOURCE_CODE_PRO, Profiler::FONT_SIZE));
+        tracer.end();
+
+        std::unique_ptr<MetricsSink> metrics;
+
+        if (!options.metricsPath.empty()) {
+            metrics = std::make_unique<MetricsSink>(options.metricsPath, options.metricsInterval);
+        }
 
         *appstate = new AppState{
+            .options = std::move(options),
             .lastCounter = SDL_GetPerformanceCounter(),
             .deltaTime = 0.0,
             .game = std::move(game),
             .menuBar = std::move(menuBar),
-#if SWEEPMINER_ENABLE_PROFILER
             .profiler = std::move(profiler),
-#else
-            .profiler = nullptr,
-#endif
+            .metrics = std::move(metrics),
         };
     } catch (const std::exception& e) {
         MIX_Quit();
@@ -207,6 +263,8 @@ SDL_AppResult SDL_AppInit(void** appstate, const int argc, char* argv[]) {
         return SDL_Fail(e.what());
     }
 
+    tracer.begin("First Frame");
+
     return SDL_APP_CONTINUE;
 }
 
@@ -241,6 +299,9 @@ SDL_AppResult SDL_AppEvent(void* appstate, SDL_Event* event) {
         } else if (code == ID_GAME_EXPERT) {
             app->game->setDifficulty(Game::Difficulty::EXPERT);
             app->game->newGame();
+        } else if (code == ID_GAME_SOUND) {
+            SoundCoalescer& sounds = app->game->getContext().getSoundCoalescer();
+            sounds.setEnabled(!sounds.isEnabled());
         } else if (code == ID_HELP_GITHUB) {
             SDL_OpenURL("https://github.com/KasimAhmic/SweepMiner");
         } else if (code == ID_HELP_REPORT_ISSUE) {
@@ -250,14 +311,19 @@ SDL_AppResult SDL_AppEvent(void* appstate, SDL_Event* event) {
         return SDL_APP_CONTINUE;
     }
 
+    if (event->type == SDL_EVENT_KEY_DOWN && event->key.key == SDLK_F5 && !event->key.repeat) {
+        Profiler::writeTrace(app->options.tracePath.c_str());
+    }
+
+    app->profiler->handleEvent(*event);
+
     app->game->handleEvent(*event);
 
     return SDL_APP_CONTINUE;
 }
 
-SDL_AppResult SDL_AppIterate(void* appstate) {
+void RenderFrame(AppState* app) {
     ProfileCall("App Iterate", {
-        const auto app = static_cast<AppState*>(appstate);
         const uint64_t currentCounter = SDL_GetPerformanceCounter();
 
         app->deltaTime =
@@ -266,14 +332,84 @@ SDL_AppResult SDL_AppIterate(void* appstate) {
 
         app->lastCounter = currentCounter;
 
-        SDL_SetRenderDrawColor(app->game->getContext().getRenderer(), SpreadColorInt(BLACK));
-        SDL_RenderClear(app->game->getContext().getRenderer());
+        RenderStats::setDrawColor(app->game->getContext().getRenderer(), SpreadColorInt(BLACK));
+        RenderStats::clear(app->game->getContext().getRenderer());
 
         app->game->render(app->deltaTime);
         app->menuBar->render();
 
         SDL_RenderPresent(app->game->getContext().getRenderer());
     })
+}
+
+SDL_AppResult SDL_AppIterate(void* appstate) {
+    const auto app = static_cast<AppState*>(appstate);
+
+    if (app->options.isHeadlessBench()) {
+        bool passed = true;
+
+        if (app->options.memoryBench) {
+            MemoryBench bench(*app->game, app->options.memoryBenchBudget);
+
+            passed = bench.run(app->options.memoryBenchPath) && passed;
+        }
+
+        if (app->options.inputBenchEvents > 0) {
+            InputBench bench(*app->game, app->options.inputBenchEvents);
+
+            passed = bench.run(
+                [app](SDL_Event& event) { return SDL_AppEvent(app, &event); },
+                app->options.inputBenchPath) && passed;
+        }
+
+        if (app->options.renderBenchFrames > 0) {
+            RenderBench bench(*app->game, app->options.renderBenchFrames);
+
+            passed = bench.run([app] { RenderFrame(app); }, app->options.renderBenchPath) && passed;
+        }
+
+        return passed ? SDL_APP_SUCCESS : SDL_APP_FAILURE;
+    }
+
+    RenderFrame(app);
+
+    Profiler::endFrame();
+
+    if (app->metrics) {
+        app->metrics->update();
+    }
+
+    if (++app->frameCount == app->options.traceFrames) {
+        Profiler::writeTrace(app->options.tracePath.c_str());
+    }
+
+    // Loading and the first frames may allocate, every frame after that is held to the budget. So are frames in which
+    // the profiler overlay rebuilt its text, which is formatted on the heap twice a second while the profiler is on
+    if (app->options.frameAllocationBudget &&
+        app->frameCount > ALLOCATION_BUDGET_WARMUP_FRAMES &&
+        !app->game->getContext().getResourceManager().isLoading() &&
+        !Profiler::getLastFrame().overlayRefreshed) {
+        const uint64_t budget = *app->options.frameAllocationBudget;
+
+        if (const uint64_t allocations = Profiler::getLastFrame().allocations; allocations > budget) {
+            SDL_LogError(
+                SDL_LOG_CATEGORY_APPLICATION,
+                "Frame %" SDL_PRIu64 " made %" SDL_PRIu64 " allocations, the budget is %" SDL_PRIu64,
+                app->frameCount,
+                allocations,
+                budget);
+
+            return SDL_APP_FAILURE;
+        }
+    }
+
+    if (StartupTracer& tracer = StartupTracer::getInstance(); !tracer.isFinished()) {
+        tracer.finish(app->options.startupTracePath.c_str());
+
+        if (app->options.exitAfterFirstFrame) {
+            return SDL_APP_SUCCESS;
+        }
+    }
 
     return SDL_APP_CONTINUE;
 }
@@ -283,6 +419,10 @@ void SDL_AppQuit(void* appstate, const SDL_AppResult result) {
 
     const auto app = static_cast<AppState*>(appstate);
 
+    if (app != nullptr && app->options.traceOnExit) {
+        Profiler::writeTrace(app->options.tracePath.c_str());
+    }
+
     delete app;
 
     SDL_QuitAll();
@@ -0,0 +1,153 @@
+#include "memory_bench.hpp"
+
+#include <format>
+
+#include <SDL3/SDL.h>
+
+#if SWEEPMINER_PLATFORM_WINDOWS
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include "metrics_csv.hpp"
+
+const std::array<MemoryBench::BoardSize, 7> MemoryBench::BOARD_SIZES = {{
+    {.name = "beginner", .rows = 9, .columns = 9, .mines = 10},
+    {.name = "intermediate", .rows = 16, .columns = 16, .mines = 40},
+    {.name = "expert", .rows = 16, .columns = 30, .mines = 99},
+    {.name = "custom_32x32", .rows = 32, .columns = 32, .mines = 200},
+    {.name = "custom_64x64", .rows = 64, .columns = 64, .mines = 255},
+    {.name = "custom_128x128", .rows = 128, .columns = 128, .mines = 255},
+    {.name = "custom_255x255", .rows = 255, .columns = 255, .mines = 255},
+}};
+
+MemoryBench::MemoryBench(Game& game, const std::optional<uint64_t> bytesPerCellBudget)
+    : game(game),
+      bytesPerCellBudget(bytesPerCellBudget) {}
+
+bool MemoryBench::run(const std::string& csvPath) {
+    bool withinBudget = true;
+
+    if (this->bytesPerCellBudget && !AllocationTracker::ENABLED) {
+        SDL_LogError(
+            SDL_LOG_CATEGORY_APPLICATION,
+            "Can't check the bytes per cell budget, heap bytes are only counted with SWEEPMINER_TRACK_ALLOCATIONS");
+
+        withinBudget = false;
+    }
+
+    SDL_Log("Memory bench: sizeof(Cell) %zu, sizeof(Board) %zu", sizeof(Cell), sizeof(Board));
+
+    // Everything a game costs regardless of its size, the background, score board and an empty grid
+    const AllocationTracker::Counters fixed = this->measure(1, 1, 0);
+
+    std::vector<Result> results;
+
+    results.reserve(BOARD_SIZES.size());
+
+    for (const BoardSize& size: BOARD_SIZES) {
+        const AllocationTracker::Counters board = this->measure(size.rows, size.columns, size.mines);
+        const uint32_t cells = static_cast<uint32_t>(size.rows) * size.columns;
+
+        const Result& result = results.emplace_back(Result{
+            .board = size.name,
+            .cells = cells,
+            .allocations = board.allocations,
+            .bytes = board.bytes,
+            .allocationsPerCell =
+                static_cast<double>(board.allocations - fixed.allocations) / static_cast<double>(cells - 1),
+            .bytesPerCell = static_cast<double>(board.bytes - fixed.bytes) / static_cast<double>(cells - 1),
+            .peakRss = getPeakRss(),
+        });
+
+        SDL_Log("%-16s %6u cells  %8" SDL_PRIu64 " allocations  %10" SDL_PRIu64 " bytes  "
+                "%6.2f allocations per cell  %8.1f bytes per cell  peak RSS %" SDL_PRIu64 " KiB",
+                result.board.c_str(),
+                result.cells,
+                result.allocations,
+                result.bytes,
+                result.allocationsPerCell,
+                result.bytesPerCell,
+                result.peakRss / 1024);
+
+        if (this->bytesPerCellBudget && AllocationTracker::ENABLED &&
+            result.bytesPerCell > static_cast<double>(*this->bytesPerCellBudget)) {
+            SDL_LogError(
+                SDL_LOG_CATEGORY_APPLICATION,
+                "The %s board takes %.1f bytes per cell, the budget is %" SDL_PRIu64,
+                result.board.c_str(),
+                result.bytesPerCell,
+                *this->bytesPerCellBudget);
+
+            withinBudget = false;
+        }
+    }
+
+    const bool written = csvPath.empty() || writeCsv(csvPath, results);
+
+    return withinBudget && written;
+}
+
+AllocationTracker::Counters MemoryBench::measure(const uint8_t rows, const uint8_t columns, const uint8_t mines) {
+    // Tears the previous game down first, so its memory is back on the heap before the new one is counted
+    this->game.newGame(std::make_unique<Board>(1, 1, std::vector<uint8_t>{0}));
+
+    const AllocationTracker::Counters before = AllocationTracker::getThreadCounters();
+
+    this->game.newGame(std::make_unique<Board>(rows, columns, mines, this->generator));
+
+    const AllocationTracker::Counters after = AllocationTracker::getThreadCounters();
+
+    return AllocationTracker::Counters{
+        .allocations = after.allocations - before.allocations,
+        .bytes = after.bytes - before.bytes,
+    };
+}
+
+uint64_t MemoryBench::getPeakRss() {
+#if SWEEPMINER_PLATFORM_WINDOWS
+    PROCESS_MEMORY_COUNTERS counters{};
+
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return 0;
+    }
+
+    return counters.PeakWorkingSetSize;
+#else
+    rusage usage{};
+
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+
+#if SWEEPMINER_PLATFORM_MACOS
+    return static_cast<uint64_t>(usage.ru_maxrss);
+#else
+    // Linux and the BSDs report kilobytes
+    return static_cast<uint64_t>(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
+
+bool MemoryBench::writeCsv(const std::string& path, const std::vector<Result>& results) {
+    MetricsCsv csv;
+
+    const auto append = [&csv](const std::string& board, const char* metric, const double value) {
+        csv.append(0.0, std::format("memory_bench.{}.{}", board, metric), value);
+    };
+
+    for (const Result& result: results) {
+        if constexpr (AllocationTracker::ENABLED) {
+            append(result.board, "allocations", static_cast<double>(result.allocations));
+            append(result.board, "bytes", static_cast<double>(result.bytes));
+            append(result.board, "allocations_per_cell", result.allocationsPerCell);
+            append(result.board, "bytes_per_cell", result.bytesPerCell);
+        }
+
+        append(result.board, "peak_rss_kib", static_cast<double>(result.peakRss) / 1024.0);
+    }
+
+    return csv.save(path);
+}
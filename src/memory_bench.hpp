@@ -0,0 +1,67 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "allocation_tracker.hpp"
+#include "game.hpp"
+
+/**
+ * Builds boards of increasing size through Game::newGame and reports the heap bytes and allocations each one takes,
+ * per board and per cell, along with the process's peak resident set size. The fixed cost of a game is measured on a
+ * 1x1 board and left out of the per cell numbers.
+ *
+ * Heap numbers come from the AllocationTracker and need a build with SWEEPMINER_TRACK_ALLOCATIONS, only the peak RSS
+ * is available without it.
+ */
+class MemoryBench {
+public:
+    struct Result {
+        std::string board;
+        uint32_t cells;
+        uint64_t allocations;
+        uint64_t bytes;
+        double allocationsPerCell;
+        double bytesPerCell;
+        uint64_t peakRss;
+    };
+
+    explicit MemoryBench(Game& game, std::optional<uint64_t> bytesPerCellBudget);
+
+    /**
+     * Builds every board, logs a report and writes it as metrics CSV when a path is given. Returns false if a board
+     * goes over the budget or the CSV couldn't be written.
+     */
+    bool run(const std::string& csvPath);
+
+private:
+    struct BoardSize {
+        const char* name;
+        uint8_t rows;
+        uint8_t columns;
+        uint8_t mines;
+    };
+
+    static constexpr uint32_t SEED = 0x5eed;
+    static const std::array<BoardSize, 7> BOARD_SIZES;
+
+    Game& game;
+    std::optional<uint64_t> bytesPerCellBudget;
+    std::mt19937 generator{SEED};
+
+    /**
+     * Heap allocations and bytes of building a game on a board of the given size.
+     */
+    AllocationTracker::Counters measure(uint8_t rows, uint8_t columns, uint8_t mines);
+
+    /**
+     * The process's peak resident set size in bytes, or 0 where it can't be read.
+     */
+    static uint64_t getPeakRss();
+
+    static bool writeCsv(const std::string& path, const std::vector<Result>& results);
+};
@@ -0,0 +1,57 @@
+#include "metrics_csv.hpp"
+
+#include <format>
+#include <iterator>
+
+MetricsCsv::MetricsCsv()
+    : text("seconds,metric,value\n") {}
+
+void MetricsCsv::append(const double seconds, const std::string_view metric, const double value) {
+    if (metric.find_first_of(",\"\r\n") == std::string_view::npos) {
+        std::format_to(std::back_inserter(this->text), "{:.3f},{},{:.3f}\n", seconds, metric, value);
+        return;
+    }
+
+    std::format_to(std::back_inserter(this->text), "{:.3f},\"", seconds);
+
+    for (const char c: metric) {
+        if (c == '"') {
+            this->text.push_back('"');
+        }
+
+        this->text.push_back(c);
+    }
+
+    std::format_to(std::back_inserter(this->text), "\",{:.3f}\n", value);
+}
+
+void MetricsCsv::reserve(const size_t size) {
+    this->text.reserve(size);
+}
+
+void MetricsCsv::clear() {
+    this->text.clear();
+}
+
+bool MetricsCsv::write(SDL_IOStream* io) const {
+    return SDL_WriteIO(io, this->text.data(), this->text.size()) == this->text.size();
+}
+
+bool MetricsCsv::save(const std::string& path) const {
+    SDL_IOStream* io = SDL_IOFromFile(path.c_str(), "w");
+
+    if (!io) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't open metrics file %s: %s", path.c_str(), SDL_GetError());
+        return false;
+    }
+
+    const bool written = this->write(io);
+
+    if (!written) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't write metrics file %s: %s", path.c_str(), SDL_GetError());
+    }
+
+    SDL_CloseIO(io);
+
+    return written;
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include <SDL3/SDL.h>
+
+/**
+ * Rows of the "seconds,metric,value" CSV format that --metrics and the benches write and sweepminer_metrics_compare
+ * reads. Metric names holding free text, such as zone labels or scene names, are quoted as RFC 4180 has it. Appending
+ * only allocates when the rows outgrow the reserved capacity.
+ */
+class MetricsCsv {
+public:
+    MetricsCsv();
+
+    void append(double seconds, std::string_view metric, double value);
+    void reserve(size_t size);
+
+    [[nodiscard]] size_t getCapacity() const { return this->text.capacity(); }
+
+    /**
+     * Drops the rows, and the header, once they've been written so the next ones can be appended to the same file.
+     */
+    void clear();
+
+    [[nodiscard]] bool write(SDL_IOStream* io) const;
+
+    /**
+     * Writes the rows to a new file at path, logging why when that fails.
+     */
+    [[nodiscard]] bool save(const std::string& path) const;
+
+private:
+    std::string text;
+};
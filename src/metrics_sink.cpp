@@ -0,0 +1,136 @@
+#include "metrics_sink.hpp"
+
+#include <format>
+#include <stdexcept>
+
+#include "profiler.hpp"
+
+MetricsSink::MetricsSink(const std::string& path, const double interval)
+    : io(SDL_IOFromFile(path.c_str(), "w")),
+      interval(static_cast<uint64_t>(interval * static_cast<double>(SDL_GetPerformanceFrequency()))),
+      start(SDL_GetPerformanceCounter()),
+      nextWrite(this->start + this->interval) {
+    if (!this->io) {
+        throw std::runtime_error(std::format("Couldn't open metrics file {}: {}", path, SDL_GetError()));
+    }
+
+    // Room for the fixed rows, rows of zones grow it as their names are cached
+    this->rows.reserve(4096);
+    this->zoneMetrics.reserve(Profiler::MAX_ZONES);
+
+    Profiler::enableIntervalPercentiles();
+}
+
+MetricsSink::~MetricsSink() {
+    // The rows of a partial interval are still written so short runs produce metrics
+    if (this->frames > 0) {
+        this->write(SDL_GetPerformanceCounter());
+    }
+
+    SDL_CloseIO(this->io);
+}
+
+void MetricsSink::update() {
+    const Profiler::FrameStats frame = Profiler::getLastFrame();
+    const uint64_t frequency = SDL_GetPerformanceFrequency();
+
+    if (frame.ticks == 0) {
+        return;
+    }
+
+    this->frameTimes.record(frame.ticks * 1'000'000'000 / frequency);
+    this->frames++;
+    this->allocations += frame.allocations;
+    this->bytes += frame.bytes;
+    this->drawCalls += frame.render.drawCalls;
+    this->vertices += frame.render.vertices;
+    this->textureBinds += frame.render.textureBinds;
+    this->stateChanges += frame.render.stateChanges;
+
+    if (const uint64_t now = SDL_GetPerformanceCounter(); now >= this->nextWrite) {
+        this->write(now);
+        this->nextWrite = now + this->interval;
+    }
+}
+
+void MetricsSink::write(const uint64_t now) {
+    // The render thread writes the rows after the frame closed, which isn't part of any frame's allocations
+    const AllocationTracker::Counters before = AllocationTracker::getThreadCounters();
+
+    this->writeRows(now);
+
+    const AllocationTracker::Counters after = AllocationTracker::getThreadCounters();
+
+    Profiler::excludeAllocations(AllocationTracker::Counters{
+        .allocations = after.allocations - before.allocations,
+        .bytes = after.bytes - before.bytes,
+    });
+}
+
+void MetricsSink::writeRows(const uint64_t now) {
+    const double seconds = static_cast<double>(now - this->start) / static_cast<double>(SDL_GetPerformanceFrequency());
+    const auto frameCount = static_cast<double>(this->frames);
+
+    this->rows.append(seconds, "frame.p50_us", static_cast<double>(this->frameTimes.getPercentile(50.0)) / 1000.0);
+    this->rows.append(seconds, "frame.p90_us", static_cast<double>(this->frameTimes.getPercentile(90.0)) / 1000.0);
+    this->rows.append(seconds, "frame.p99_us", static_cast<double>(this->frameTimes.getPercentile(99.0)) / 1000.0);
+    this->rows.append(seconds, "frame.p99.9_us", static_cast<double>(this->frameTimes.getPercentile(99.9)) / 1000.0);
+    this->rows.append(seconds, "frame.max_us", static_cast<double>(this->frameTimes.getMax()) / 1000.0);
+
+    if constexpr (AllocationTracker::ENABLED) {
+        this->rows.append(seconds, "frame.allocations", static_cast<double>(this->allocations) / frameCount);
+        this->rows.append(seconds, "frame.bytes", static_cast<double>(this->bytes) / frameCount);
+    }
+
+    this->rows.append(seconds, "render.draw_calls", static_cast<double>(this->drawCalls) / frameCount);
+    this->rows.append(seconds, "render.vertices", static_cast<double>(this->vertices) / frameCount);
+    this->rows.append(seconds, "render.texture_binds", static_cast<double>(this->textureBinds) / frameCount);
+    this->rows.append(seconds, "render.state_changes", static_cast<double>(this->stateChanges) / frameCount);
+
+    // Taken for every zone, so calls from before the profiler was switched off don't end up in a later interval
+    const size_t zoneCount = Profiler::getZoneCount();
+
+    for (size_t i = this->zoneMetrics.size(); i < zoneCount; i++) {
+        const std::string prefix = std::format("zone.{}.", Profiler::getZoneLabel(static_cast<Profiler::ZoneId>(i)));
+        const ZoneMetrics& metrics = this->zoneMetrics.emplace_back(ZoneMetrics{
+            .p50 = prefix + "p50_us",
+            .p99 = prefix + "p99_us",
+            .max = prefix + "max_us",
+        });
+        const size_t names = metrics.p50.size() + metrics.p99.size() + metrics.max.size();
+
+        // Quoting at most doubles a name
+        this->rows.reserve(this->rows.getCapacity() + 2 * names + 3 * ROW_SIZE);
+    }
+
+    for (size_t i = 0; i < zoneCount; i++) {
+        const auto zone = static_cast<Profiler::ZoneId>(i);
+        const Profiler::Percentiles percentiles = Profiler::takeIntervalPercentiles(zone);
+
+        if (!Profiler::isEnabled() || percentiles.count == 0) {
+            continue;
+        }
+
+        const ZoneMetrics& metrics = this->zoneMetrics[i];
+
+        this->rows.append(seconds, metrics.p50, percentiles.p50);
+        this->rows.append(seconds, metrics.p99, percentiles.p99);
+        this->rows.append(seconds, metrics.max, percentiles.max);
+    }
+
+    if (!this->rows.write(this->io)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't write metrics: %s", SDL_GetError());
+    }
+
+    SDL_FlushIO(this->io);
+
+    this->rows.clear();
+    this->frameTimes.clear();
+    this->frames = 0;
+    this->allocations = 0;
+    this->bytes = 0;
+    this->drawCalls = 0;
+    this->vertices = 0;
+    this->textureBinds = 0;
+    this->stateChanges = 0;
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <SDL3/SDL.h>
+
+#include "histogram.hpp"
+#include "metrics_csv.hpp"
+
+/**
+ * Periodically appends frame time percentiles, per frame allocation and renderer counts and the profiler's zone
+ * percentiles to a CSV file with one "seconds,metric,value" row per metric, for comparing runs with
+ * sweepminer_metrics_compare. Every row covers only the interval since the previous write, zone percentiles are only
+ * written while the profiler is enabled.
+ */
+class MetricsSink {
+public:
+    explicit MetricsSink(const std::string& path, double interval);
+    ~MetricsSink();
+
+    MetricsSink(const MetricsSink&) = delete;
+    MetricsSink& operator=(const MetricsSink&) = delete;
+
+    /**
+     * Adds the frame the profiler just closed and writes the rows once the interval has elapsed.
+     */
+    void update();
+
+private:
+    /**
+     * A zone's metric names, built once when the zone first shows up so writes don't allocate.
+     */
+    struct ZoneMetrics {
+        std::string p50;
+        std::string p99;
+        std::string max;
+    };
+
+    // Enough for the seconds and value columns of any row
+    static constexpr size_t ROW_SIZE = 64;
+
+    SDL_IOStream* io;
+    uint64_t interval;
+    uint64_t start;
+    uint64_t nextWrite;
+    MetricsCsv rows{};
+
+    Histogram frameTimes{};
+    uint64_t frames{0};
+    uint64_t allocations{0};
+    uint64_t bytes{0};
+    uint64_t drawCalls{0};
+    uint64_t vertices{0};
+    uint64_t textureBinds{0};
+    uint64_t stateChanges{0};
+    std::vector<ZoneMetrics> zoneMetrics{};
+
+    void write(uint64_t now);
+    void writeRows(uint64_t now);
+};
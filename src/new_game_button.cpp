@@ -1,6 +1,7 @@
 #include "new_game_button.hpp"
 
 #include "events.hpp"
+#include "render_stats.hpp"
 #include "textures.hpp"
 
 NewGameButton::NewGameButton(Context *context, const SDL_FRect &rect)
@@ -41,7 +42,7 @@ void NewGameButton::render() {
         destRect.y += PRESSED_OFFSET * this->getContext().getDisplayScale();
     }
 
-    SDL_RenderTexture(
+    RenderStats::renderTexture(
         this->getContext().getRenderer(),
         this->getContext().getResourceManager().getTexture(ResourceManager::Texture::SMILEY),
         &srcRect,
@@ -0,0 +1,123 @@
+#include "options.hpp"
+
+#include <charconv>
+#include <string_view>
+
+#include <SDL3/SDL.h>
+
+namespace {
+    constexpr uint64_t DEFAULT_RENDER_BENCH_FRAMES = 300;
+    constexpr uint64_t DEFAULT_INPUT_BENCH_EVENTS = 1'000'000;
+
+    bool ParseValue(const std::string_view arg, const std::string_view prefix, std::string_view& value) {
+        if (!arg.starts_with(prefix)) {
+            return false;
+        }
+
+        value = arg.substr(prefix.size());
+
+        return true;
+    }
+
+    bool ParseNumber(const std::string_view value, uint64_t& number) {
+        const auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), number);
+
+        return error == std::errc{} && end == value.data() + value.size();
+    }
+
+    bool ParseNumber(const std::string_view value, double& number) {
+        const auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), number);
+
+        return error == std::errc{} && end == value.data() + value.size();
+    }
+}
+
+Options ParseOptions(const int argc, char* argv[]) {
+    Options options{};
+
+    if (const char* profiler = SDL_getenv("SWEEPMINER_PROFILER"); profiler != nullptr) {
+        options.profiler = std::string_view(profiler) != "0" && profiler[0] != '\0';
+    }
+
+    for (int i = 1; i < argc; i++) {
+        const std::string_view arg = argv[i];
+        std::string_view value;
+
+        if (arg == "--exit-after-first-frame") {
+            options.exitAfterFirstFrame = true;
+        } else if (arg == "--profiler") {
+            options.profiler = true;
+        } else if (ParseValue(arg, "--startup-trace=", value)) {
+            options.startupTracePath = value;
+        } else if (ParseValue(arg, "--trace=", value)) {
+            options.tracePath = value;
+            options.traceOnExit = true;
+            options.profiler = true;
+        } else if (ParseValue(arg, "--trace-frames=", value)) {
+            if (ParseNumber(value, options.traceFrames)) {
+                options.profiler = true;
+            } else {
+                SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Ignoring invalid frame count: %s", argv[i]);
+            }
+        } else if (ParseValue(arg, "--frame-alloc-budget=", value)) {
+            if (uint64_t budget = 0; ParseNumber(value, budget)) {
+                options.frameAllocationBudget = budget;
+            } else {
+                SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Ignoring invalid allocation budget: %s", argv[i]);
+            }
+        } else if (ParseValue(arg, "--metrics=", value)) {
+            options.metricsPath = value;
+            options.profiler = true;
+        } else if (ParseValue(arg, "--metrics-interval=", value)) {
+            if (double interval = 0.0; ParseNumber(value, interval) && interval > 0.0) {
+                options.metricsInterval = interval;
+            } else {
+                SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Ignoring invalid metrics interval: %s", argv[i]);
+            }
+        } else if (arg == "--render-bench") {
+            options.renderBenchFrames = DEFAULT_RENDER_BENCH_FRAMES;
+        } else if (ParseValue(arg, "--render-bench=", value)) {
+            if (uint64_t frames = 0; ParseNumber(value, frames) && frames > 0) {
+                options.renderBenchFrames = frames;
+            } else {
+                SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Ignoring invalid frame count: %s", argv[i]);
+            }
+        } else if (ParseValue(arg, "--render-bench-csv=", value)) {
+            options.renderBenchPath = value;
+
+            if (options.renderBenchFrames == 0) {
+                options.renderBenchFrames = DEFAULT_RENDER_BENCH_FRAMES;
+            }
+        } else if (arg == "--memory-bench") {
+            options.memoryBench = true;
+        } else if (ParseValue(arg, "--memory-bench-budget=", value)) {
+            if (uint64_t budget = 0; ParseNumber(value, budget)) {
+                options.memoryBenchBudget = budget;
+                options.memoryBench = true;
+            } else {
+                SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Ignoring invalid bytes per cell budget: %s", argv[i]);
+            }
+        } else if (ParseValue(arg, "--memory-bench-csv=", value)) {
+            options.memoryBenchPath = value;
+            options.memoryBench = true;
+        } else if (arg == "--input-bench") {
+            options.inputBenchEvents = DEFAULT_INPUT_BENCH_EVENTS;
+        } else if (ParseValue(arg, "--input-bench=", value)) {
+            if (uint64_t events = 0; ParseNumber(value, events) && events > 0) {
+                options.inputBenchEvents = events;
+            } else {
+                SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Ignoring invalid event count: %s", argv[i]);
+            }
+        } else if (ParseValue(arg, "--input-bench-csv=", value)) {
+            options.inputBenchPath = value;
+
+            if (options.inputBenchEvents == 0) {
+                options.inputBenchEvents = DEFAULT_INPUT_BENCH_EVENTS;
+            }
+        } else {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Ignoring unknown argument: %s", argv[i]);
+        }
+    }
+
+    return options;
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+
+struct Options {
+    /**
+     * Quit as soon as the first frame has been presented, for benchmarking startup in a loop.
+     */
+    bool exitAfterFirstFrame{false};
+
+    /**
+     * Where to write the startup trace as JSON. Empty to only log it.
+     */
+    std::string startupTracePath{};
+
+    /**
+     * Start with the profiler enabled. Also set by a SWEEPMINER_PROFILER environment variable other than 0, and by the
+     * trace and metrics options.
+     */
+    bool profiler{false};
+
+    /**
+     * Where to write the profiler's Chrome trace. Written on exit when given on the command line, and whenever the
+     * trace hotkey is pressed.
+     */
+    std::string tracePath{"sweepminer_trace.json"};
+    bool traceOnExit{false};
+
+    /**
+     * Write the profiler trace once this many frames have been presented, 0 to disable.
+     */
+    uint64_t traceFrames{0};
+
+    /**
+     * Fail once a steady state frame makes more heap allocations than this. Requires a build with
+     * SWEEPMINER_TRACK_ALLOCATIONS.
+     */
+    std::optional<uint64_t> frameAllocationBudget{};
+
+    /**
+     * Where to write periodic metrics as CSV. Empty to disable.
+     */
+    std::string metricsPath{};
+
+    /**
+     * Seconds between metrics writes.
+     */
+    double metricsInterval{1.0};
+
+    /**
+     * Frames to render of every render bench scene before quitting, 0 to play normally. The bench prefers SDL's
+     * offscreen video driver and the software renderer unless SDL_VIDEO_DRIVER or SDL_RENDER_DRIVER say otherwise.
+     */
+    uint64_t renderBenchFrames{0};
+
+    /**
+     * Where to write the render bench results as metrics CSV, which also turns the bench on. Empty to only log them.
+     */
+    std::string renderBenchPath{};
+
+    /**
+     * Build boards of increasing size, report what they cost in memory and quit. Runs on the same drivers as the
+     * render bench.
+     */
+    bool memoryBench{false};
+
+    /**
+     * Fail the memory bench when a board takes more heap bytes per cell than this. Requires a build with
+     * SWEEPMINER_TRACK_ALLOCATIONS.
+     */
+    std::optional<uint64_t> memoryBenchBudget{};
+
+    /**
+     * Where to write the memory bench results as metrics CSV. Empty to only log them.
+     */
+    std::string memoryBenchPath{};
+
+    /**
+     * Synthetic input events to inject into every input bench scenario before quitting, 0 to play normally. Runs on the
+     * same drivers as the render bench.
+     */
+    uint64_t inputBenchEvents{0};
+
+    /**
+     * Where to write the input bench results as metrics CSV, which also turns the bench on. Empty to only log them.
+     */
+    std::string inputBenchPath{};
+
+    [[nodiscard]] bool isHeadlessBench() const {
+        return this->renderBenchFrames > 0 || this->memoryBench || this->inputBenchEvents > 0;
+    }
+};
+
+Options ParseOptions(int argc, char* argv[]);
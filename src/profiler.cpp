@@ -1,34 +1,116 @@
 #include "profiler.hpp"
 
+#include <algorithm>
+#include <cstring>
 #include <format>
-#include <ranges>
+#include <mutex>
+#include <stdexcept>
+#include <string_view>
 
+#include "color.hpp"
+#include "render_stats.hpp"
 #include "resource_manager.hpp"
 
 Profiler* Profiler::instance = nullptr;
+std::atomic<bool> Profiler::enabled{false};
+bool Profiler::wasEnabled = false;
+std::array<const char*, Profiler::MAX_ZONES> Profiler::labels{};
+std::atomic<size_t> Profiler::zoneCount{0};
+std::array<Profiler::Stat, Profiler::MAX_ZONES> Profiler::stats{};
+std::array<Profiler::ZoneHistogram, Profiler::MAX_ZONES> Profiler::histograms{};
+bool Profiler::intervalPercentiles = false;
+std::array<Histogram, Profiler::MAX_ZONES> Profiler::intervalHistograms{};
+thread_local uint16_t Profiler::depth = 0;
+thread_local Profiler::ThreadBuffer* Profiler::threadBuffer = nullptr;
+std::vector<std::unique_ptr<Profiler::ThreadBuffer>> Profiler::threadBuffers{};
+uint16_t Profiler::renderThread = 0;
+std::array<Profiler::ZoneEvent, Profiler::MAX_FRAME_EVENTS> Profiler::frameEvents{};
+size_t Profiler::frameEventCount = 0;
+uint64_t Profiler::droppedEvents = 0;
+uint64_t Profiler::frameStart = 0;
+AllocationTracker::Counters Profiler::frameAllocations{};
+Profiler::FrameStats Profiler::lastFrame{};
+bool Profiler::overlayRefreshed = false;
+std::array<Profiler::FrameCapture, Profiler::WORST_FRAME_SECONDS> Profiler::captures{};
+std::array<Profiler::ZoneEvent, Profiler::TRACE_CAPACITY> Profiler::trace{};
+size_t Profiler::traceHead = 0;
+size_t Profiler::traceSize = 0;
+std::array<Profiler::TraceFrame, Profiler::TRACE_FRAMES> Profiler::traceFrames{};
+size_t Profiler::traceFrameHead = 0;
+size_t Profiler::traceFrameSize = 0;
 
-Profiler::Profiler(SDL_Renderer* renderer, TTF_TextEngine* textEngine)
+std::array<Profiler::GraphFrame, Profiler::GRAPH_FRAMES> Profiler::graph{};
+std::array<bool, Profiler::MAX_ZONES> Profiler::graphedZones{};
+size_t Profiler::graphHead = 0;
+
+namespace {
+    std::mutex registryMutex;
+
+    constexpr Color BACKGROUND_COLOR{0, 0, 0, 200};
+    constexpr Color UNTRACKED_COLOR{90, 90, 90, 255};
+    constexpr Color BUDGET_COLOR{255, 255, 255, 160};
+
+    constexpr std::array<Color, Profiler::GRAPH_SERIES> SERIES_COLORS{
+        Color{230, 25, 75},
+        Color{60, 180, 75},
+        Color{255, 225, 25},
+        Color{67, 99, 216},
+        Color{245, 130, 49},
+        Color{145, 30, 180},
+        Color{70, 240, 240},
+        Color{200, 200, 200},
+    };
+
+    // Zone labels and thread names are free text
+    std::string EscapeJson(const std::string_view text) {
+        std::string escaped;
+
+        escaped.reserve(text.size());
+
+        for (const char c: text) {
+            switch (c) {
+                case '"':
+                    escaped.append("\\\"");
+                    break;
+                case '\\':
+                    escaped.append("\\\\");
+                    break;
+                case '\n':
+                    escaped.append("\\n");
+                    break;
+                case '\r':
+                    escaped.append("\\r");
+                    break;
+                case '\t':
+                    escaped.append("\\t");
+                    break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20) {
+                        escaped.append(std::format("\\u{:04x}", static_cast<unsigned>(c)));
+                    } else {
+                        escaped.push_back(c);
+                    }
+            }
+        }
+
+        return escaped;
+    }
+}
+
+Profiler::Profiler(SDL_Renderer* renderer, TTF_TextEngine* textEngine, TTF_Font* font)
     : renderer(renderer),
       textEngine(textEngine),
       rect(SDL_FRect{}),
       freq(static_cast<double>(SDL_GetPerformanceFrequency())),
       accumulator(0.0),
       frameCount(0),
-      fps(0.0)
+      fps(0.0),
+      view(View::ZONES),
+      refresh(false),
+      font(font),
+      textWidth(0),
+      textHeight(0)
 {
-    SDL_Surface* surface = SDL_CreateSurface(100, 100, SDL_PIXELFORMAT_RGBA32);
-    SDL_SetSurfaceBlendMode(surface, SDL_BLENDMODE_BLEND);
-
-    const SDL_PixelFormatDetails* details = SDL_GetPixelFormatDetails(surface->format);
-    SDL_FillSurfaceRect(surface, nullptr, SDL_MapRGBA(details, nullptr, 0, 0, 0, 200));
-
-    this->background = SDL_CreateTextureFromSurface(this->renderer, surface);
-    SDL_DestroySurface(surface);
-
-    SDL_SetTextureBlendMode(this->background, SDL_BLENDMODE_BLEND);
-
-    this->font = TTF_OpenFont("assets/fonts/SourceCodePro-Medium.ttf", FONT_SIZE * SDL_GetWindowDisplayScale(SDL_GetRenderWindow(this->renderer)));
-
     this->text = TTF_CreateText(
         this->textEngine,
         this->font,
@@ -36,11 +118,21 @@ Profiler::Profiler(SDL_Renderer* renderer, TTF_TextEngine* textEngine)
         0);
     TTF_SetTextWrapWidth(this->text, 0);
 
+    this->rows.reserve(MAX_ZONES + 16);
+    this->vertices.reserve(MAX_QUADS * 4);
+    this->indices.reserve(MAX_QUADS * 6);
+
+    for (int quad = 0; quad < static_cast<int>(MAX_QUADS); quad++) {
+        const int first = quad * 4;
+
+        this->indices.insert(this->indices.end(), {first, first + 1, first + 2, first + 2, first + 3, first});
+    }
+
     Profiler::instance = this;
 }
 
 Profiler::~Profiler() {
-    TTF_CloseFont(this->font);
+    TTF_DestroyText(this->text);
 }
 
 Profiler& Profiler::getInstance() {
@@ -51,54 +143,947 @@ Profiler& Profiler::getInstance() {
     return *instance;
 }
 
-void Profiler::render(const double deltaTime) {
-    this->frameCount++;
-    this->accumulator += deltaTime;
+void Profiler::setEnabled(const bool value) {
+    enabled.store(value, std::memory_order_relaxed);
+
+    SDL_Log("Profiler %s", value ? "enabled" : "disabled");
+}
+
+Profiler::ZoneId Profiler::registerZone(const char* label) {
+    const std::lock_guard lock(registryMutex);
+
+    const size_t count = zoneCount.load(std::memory_order_relaxed);
+
+    for (size_t i = 0; i < count; i++) {
+        if (std::strcmp(labels[i], label) == 0) {
+            return static_cast<ZoneId>(i);
+        }
+    }
+
+    // The last slot is shared by every zone registered once the table is full
+    if (count == MAX_ZONES - 1) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Profiler zone limit reached, recording \"%s\" as \"Other\"", label);
+
+        labels[count] = "Other";
+        zoneCount.store(MAX_ZONES, std::memory_order_release);
+
+        return static_cast<ZoneId>(count);
+    }
+
+    if (count == MAX_ZONES) {
+        return static_cast<ZoneId>(MAX_ZONES - 1);
+    }
+
+    labels[count] = label;
+    zoneCount.store(count + 1, std::memory_order_release);
+
+    return static_cast<ZoneId>(count);
+}
+
+Profiler::ThreadBuffer* Profiler::acquireThreadBuffer() {
+    // Hands the buffer back once the owning thread exits
+    struct Lease {
+        ThreadBuffer* buffer{nullptr};
+
+        ~Lease() {
+            if (this->buffer != nullptr) {
+                this->buffer->active.store(false, std::memory_order_release);
+            }
+        }
+    };
+
+    thread_local Lease lease;
+
+    const std::lock_guard lock(registryMutex);
+
+    ThreadBuffer* buffer = nullptr;
+
+    for (const auto& candidate: threadBuffers) {
+        const bool drained = candidate->head.load(std::memory_order_acquire) ==
+                             candidate->tail.load(std::memory_order_acquire);
+
+        if (!candidate->active.load(std::memory_order_acquire) && drained) {
+            buffer = candidate.get();
+            break;
+        }
+    }
+
+    if (buffer == nullptr) {
+        threadBuffers.push_back(std::make_unique<ThreadBuffer>());
+
+        buffer = threadBuffers.back().get();
+        buffer->index = static_cast<uint16_t>(threadBuffers.size() - 1);
+    }
+
+    // A reused buffer starts over, the counts of the thread that had it don't carry over to this one
+    buffer->name = std::format("Thread {}", buffer->index);
+    buffer->recorded = 0;
+    buffer->dropped.store(0, std::memory_order_relaxed);
+    buffer->active.store(true, std::memory_order_release);
+
+    lease.buffer = buffer;
+    threadBuffer = buffer;
+
+    return buffer;
+}
+
+void Profiler::setThreadName(const char* name) {
+    ThreadBuffer* buffer = threadBuffer != nullptr ? threadBuffer : acquireThreadBuffer();
+
+    const std::lock_guard lock(registryMutex);
+
+    buffer->name = name;
+}
+
+std::vector<Profiler::ThreadInfo> Profiler::getThreads() {
+    const std::lock_guard lock(registryMutex);
+
+    std::vector<ThreadInfo> threads;
+    threads.reserve(threadBuffers.size());
+
+    for (const auto& buffer: threadBuffers) {
+        threads.push_back(ThreadInfo{
+            .name = buffer->name,
+            .recorded = buffer->recorded,
+            .dropped = buffer->dropped.load(std::memory_order_relaxed),
+        });
+    }
+
+    return threads;
+}
+
+void Profiler::drainThreads() {
+    const std::lock_guard lock(registryMutex);
+
+    for (const auto& buffer: threadBuffers) {
+        const size_t tail = buffer->tail.load(std::memory_order_relaxed);
+        const size_t head = buffer->head.load(std::memory_order_acquire);
+
+        for (size_t i = tail; i < head; i++) {
+            if (frameEventCount < MAX_FRAME_EVENTS) [[likely]] {
+                frameEvents[frameEventCount++] = buffer->events[i % THREAD_BUFFER_CAPACITY];
+            } else {
+                droppedEvents++;
+            }
+        }
+
+        buffer->recorded += head - tail;
+        buffer->tail.store(head, std::memory_order_release);
+    }
+}
+
+void Profiler::endFrame() {
+    static const ZoneId frameZone = registerZone("Frame");
+
+    const AllocationTracker::Counters allocated = AllocationTracker::getThreadCounters();
+    const RenderStats::Counters rendered = RenderStats::endFrame();
+    const uint64_t now = SDL_GetPerformanceCounter();
+    const uint64_t start = frameStart;
+
+    // Frame totals are kept even while the profiler is disabled so allocation budgets can always be checked
+    if (start != 0) {
+        lastFrame = FrameStats{
+            .ticks = now - start,
+            .allocations = allocated.allocations - frameAllocations.allocations,
+            .bytes = allocated.bytes - frameAllocations.bytes,
+            .render = rendered,
+            .overlayRefreshed = overlayRefreshed,
+        };
+    }
+
+    frameStart = now;
+    overlayRefreshed = false;
+    frameAllocations = allocated;
+
+    const bool isEnabledNow = isEnabled();
+
+    // Zones of the frame in which the profiler was switched on or off only cover part of it, so they are dropped
+    if (!isEnabledNow || !wasEnabled) {
+        if (isEnabledNow || wasEnabled) {
+            drainThreads();
+            frameEventCount = 0;
+        }
+
+        wasEnabled = isEnabledNow;
+
+        return;
+    }
+
+    renderThread = (threadBuffer != nullptr ? threadBuffer : acquireThreadBuffer())->index;
+
+    drainThreads();
+
+    const uint64_t frequency = SDL_GetPerformanceFrequency();
+    const uint64_t second = now / frequency;
+    const double nsPerTick = 1'000'000'000.0 / static_cast<double>(frequency);
+
+    for (size_t i = 0; i < frameEventCount; i++) {
+        const ZoneEvent& event = frameEvents[i];
+
+        updateZone(event, second, nsPerTick);
+    }
+
+    if (start != 0) {
+        const uint64_t ticks = now - start;
+
+        updateGraph(ticks, 1000.0 / static_cast<double>(frequency));
+
+        const ZoneEvent frame{
+            .zone = frameZone,
+            .thread = renderThread,
+            .depth = 0,
+            .allocations = static_cast<uint32_t>(lastFrame.allocations),
+            .bytes = static_cast<uint32_t>(lastFrame.bytes),
+            .start = start,
+            .end = now,
+        };
+
+        updateZone(frame, second, nsPerTick);
+        appendTrace(frame);
+
+        for (size_t i = 0; i < frameEventCount; i++) {
+            appendTrace(frameEvents[i]);
+        }
+
+        traceFrames[traceFrameHead] = TraceFrame{.start = start, .render = rendered};
+        traceFrameHead = (traceFrameHead + 1) % TRACE_FRAMES;
+        traceFrameSize = std::min(traceFrameSize + 1, TRACE_FRAMES);
+
+        FrameCapture& capture = captures[second % WORST_FRAME_SECONDS];
+
+        if (capture.second != second) {
+            capture.second = second;
+            capture.ticks = 0;
+        }
+
+        if (ticks > capture.ticks) {
+            capture.start = start;
+            capture.ticks = ticks;
+            capture.allocations = lastFrame.allocations;
+            capture.render = rendered;
+            capture.eventCount = frameEventCount;
+
+            std::copy_n(frameEvents.begin(), frameEventCount, capture.events.begin());
+        }
+    }
+
+    frameEventCount = 0;
+}
+
+void Profiler::updateGraph(const uint64_t frameTicks, const double msPerTick) {
+    GraphFrame& frame = graph[graphHead];
+
+    frame.frameMs = static_cast<float>(static_cast<double>(frameTicks) * msPerTick);
+    frame.seriesMs.fill(0.0f);
+
+    // A thread's zones arrive children first, so the time of the children at the next depth can be subtracted from
+    // each zone as it is reached
+    std::array<uint64_t, MAX_DEPTH + 1> childTicks{};
+
+    for (size_t i = 0; i < frameEventCount; i++) {
+        const ZoneEvent& event = frameEvents[i];
+
+        if (event.thread != renderThread || event.depth >= MAX_DEPTH) {
+            continue;
+        }
+
+        const uint64_t ticks = event.end - event.start;
+        const uint64_t selfTicks = ticks - std::min(ticks, childTicks[event.depth + 1]);
+
+        childTicks[event.depth + 1] = 0;
+        childTicks[event.depth] += ticks;
+
+        const size_t series = std::min<size_t>(event.zone, GRAPH_SERIES - 1);
+
+        frame.seriesMs[series] += static_cast<float>(static_cast<double>(selfTicks) * msPerTick);
+        graphedZones[event.zone] = true;
+    }
+
+    graphHead = (graphHead + 1) % GRAPH_FRAMES;
+}
+
+void Profiler::updateZone(const ZoneEvent& event, const uint64_t second, const double nsPerTick) {
+    const uint64_t ticks = event.end - event.start;
+    const auto allocations = static_cast<double>(event.allocations);
+    Stat& stat = stats[event.zone];
+
+    stat.lastTicks = ticks;
+    stat.avgTicks = stat.calls == 0 ? static_cast<double>(ticks) : stat.avgTicks * 0.9 + static_cast<double>(ticks) * 0.1;
+    stat.lastAllocations = event.allocations;
+    stat.lastBytes = event.bytes;
+    stat.avgAllocations = stat.calls == 0 ? allocations : stat.avgAllocations * 0.9 + allocations * 0.1;
+    stat.calls++;
+
+    ZoneHistogram& histogram = histograms[event.zone];
+    const uint64_t period = second / HISTOGRAM_WINDOW_SECONDS;
+    const size_t window = period % HISTOGRAM_WINDOWS;
+
+    if (histogram.periods[window] != period) {
+        histogram.periods[window] = period;
+        histogram.windows[window].clear();
+    }
+
+    const auto ns = static_cast<uint64_t>(static_cast<double>(ticks) * nsPerTick);
+
+    histogram.windows[window].record(ns);
+
+    if (intervalPercentiles) {
+        intervalHistograms[event.zone].record(ns);
+    }
+}
+
+Profiler::Percentiles Profiler::getPercentiles(const ZoneId zone) {
+    const uint64_t period = SDL_GetPerformanceCounter() / SDL_GetPerformanceFrequency() / HISTOGRAM_WINDOW_SECONDS;
+    const ZoneHistogram& histogram = histograms[zone];
+
+    Histogram merged;
+
+    for (size_t i = 0; i < HISTOGRAM_WINDOWS; i++) {
+        if (period - histogram.periods[i] < HISTOGRAM_WINDOWS) {
+            merged.merge(histogram.windows[i]);
+        }
+    }
+
+    return toPercentiles(merged);
+}
+
+Profiler::Percentiles Profiler::takeIntervalPercentiles(const ZoneId zone) {
+    Histogram& histogram = intervalHistograms[zone];
+    const Percentiles percentiles = toPercentiles(histogram);
+
+    histogram.clear();
+
+    return percentiles;
+}
+
+Profiler::Percentiles Profiler::toPercentiles(const Histogram& histogram) {
+    return Percentiles{
+        .count = histogram.getCount(),
+        .p50 = static_cast<double>(histogram.getPercentile(50.0)) / 1000.0,
+        .p90 = static_cast<double>(histogram.getPercentile(90.0)) / 1000.0,
+        .p99 = static_cast<double>(histogram.getPercentile(99.0)) / 1000.0,
+        .p999 = static_cast<double>(histogram.getPercentile(99.9)) / 1000.0,
+        .max = static_cast<double>(histogram.getMax()) / 1000.0,
+    };
+}
+
+void Profiler::appendTrace(const ZoneEvent& event) {
+    trace[traceHead] = event;
+    traceHead = (traceHead + 1) % TRACE_CAPACITY;
+    traceSize = std::min(traceSize + 1, TRACE_CAPACITY);
+}
+
+void Profiler::excludeAllocations(const AllocationTracker::Counters& excluded) {
+    frameAllocations.allocations += excluded.allocations;
+    frameAllocations.bytes += excluded.bytes;
+}
+
+void Profiler::writeTrace(const char* path) {
+    const AllocationTracker::Counters before = AllocationTracker::getThreadCounters();
+
+    writeTraceFile(path);
+
+    const AllocationTracker::Counters after = AllocationTracker::getThreadCounters();
+
+    excludeAllocations(AllocationTracker::Counters{
+        .allocations = after.allocations - before.allocations,
+        .bytes = after.bytes - before.bytes,
+    });
+}
+
+void Profiler::writeTraceFile(const char* path) {
+    if (traceSize == 0) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Profiler trace is empty, enable the profiler with F3 or --profiler");
+    }
+
+    const size_t first = (traceHead + TRACE_CAPACITY - traceSize) % TRACE_CAPACITY;
+    const double usPerTick = 1'000'000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
+
+    uint64_t origin = UINT64_MAX;
+
+    for (size_t i = 0; i < traceSize; i++) {
+        origin = std::min(origin, trace[(first + i) % TRACE_CAPACITY].start);
+    }
+
+    std::string json = "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n";
+    json.reserve(traceSize * 96);
+
+    const std::vector<ThreadInfo> threads = getThreads();
+    const char* separator = "";
+
+    for (size_t i = 0; i < threads.size(); i++) {
+        json.append(std::format(
+            "{}{{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": {}, \"args\": {{\"name\": \"{}\"}}}}",
+            separator,
+            i + 1,
+            EscapeJson(threads[i].name)));
+
+        separator = ",\n";
+    }
+
+    for (size_t i = 0; i < traceSize; i++) {
+        const ZoneEvent& event = trace[(first + i) % TRACE_CAPACITY];
+
+        json.append(std::format(
+            "{}{{\"name\": \"{}\", \"cat\": \"zone\", \"ph\": \"X\", \"ts\": {:.3f}, \"dur\": {:.3f}, \"pid\": 1, \"tid\": {}",
+            separator,
+            EscapeJson(labels[event.zone]),
+            static_cast<double>(event.start - origin) * usPerTick,
+            static_cast<double>(event.end - event.start) * usPerTick,
+            event.thread + 1));
+
+        if constexpr (AllocationTracker::ENABLED) {
+            json.append(std::format(
+                ", \"args\": {{\"allocations\": {}, \"bytes\": {}}}",
+                event.allocations,
+                event.bytes));
+        }
+
+        json.append("}");
+
+        separator = ",\n";
+    }
 
-    if (this->accumulator >= UPDATE_INTERVAL) {
-        this->fps = static_cast<double>(this->frameCount) / this->accumulator;
+    const size_t firstFrame = (traceFrameHead + TRACE_FRAMES - traceFrameSize) % TRACE_FRAMES;
 
-        uint16_t maxLen = 0;
+    // Frames older than the oldest zone left in the ring are skipped so the counter track lines up with the zones
+    for (size_t i = 0; i < traceFrameSize; i++) {
+        const auto& [frameStart, render] = traceFrames[(firstFrame + i) % TRACE_FRAMES];
 
-        for (const auto &label: this->stats | std::views::keys) {
-            if (const size_t len = strlen(label); len > maxLen) {
-                maxLen = len;
+        if (frameStart < origin) {
+            continue;
+        }
+
+        json.append(std::format(
+            "{}{{\"name\": \"Renderer\", \"ph\": \"C\", \"ts\": {:.3f}, \"pid\": 1, \"args\": {{\"drawCalls\": {}, "
+            "\"vertices\": {}, \"textureBinds\": {}, \"stateChanges\": {}}}}}",
+            separator,
+            static_cast<double>(frameStart - origin) * usPerTick,
+            render.drawCalls,
+            render.vertices,
+            render.textureBinds,
+            render.stateChanges));
+
+        separator = ",\n";
+    }
+
+    json.append("\n],\n\"zonePercentilesUs\": {\n");
+
+    const size_t count = zoneCount.load(std::memory_order_acquire);
+    bool firstZone = true;
+
+    for (size_t i = 0; i < count; i++) {
+        if (stats[i].calls == 0) {
+            continue;
+        }
+
+        const auto [samples, p50, p90, p99, p999, max] = getPercentiles(static_cast<ZoneId>(i));
+
+        json.append(std::format(
+            "{}\"{}\": {{\"count\": {}, \"p50\": {:.3f}, \"p90\": {:.3f}, \"p99\": {:.3f}, \"p99.9\": {:.3f}, \"max\": {:.3f}}}\n",
+            firstZone ? "" : ",",
+            EscapeJson(labels[i]),
+            samples,
+            p50,
+            p90,
+            p99,
+            p999,
+            max));
+
+        firstZone = false;
+    }
+
+    json.append("}");
+
+    if constexpr (AllocationTracker::ENABLED) {
+        json.append(",\n\"zoneAllocations\": {\n");
+
+        firstZone = true;
+
+        for (size_t i = 0; i < count; i++) {
+            const Stat& stat = stats[i];
+
+            if (stat.calls == 0) {
+                continue;
+            }
+
+            json.append(std::format(
+                "{}\"{}\": {{\"lastAllocations\": {}, \"lastBytes\": {}, \"avgAllocations\": {:.3f}}}\n",
+                firstZone ? "" : ",",
+                EscapeJson(labels[i]),
+                stat.lastAllocations,
+                stat.lastBytes,
+                stat.avgAllocations));
+
+            firstZone = false;
+        }
+
+        json.append("}");
+    }
+
+    json.append("}\n");
+
+    SDL_IOStream* io = SDL_IOFromFile(path, "w");
+    if (!io) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't write profiler trace to %s: %s", path, SDL_GetError());
+        return;
+    }
+
+    const bool written = SDL_WriteIO(io, json.data(), json.size()) == json.size();
+
+    SDL_CloseIO(io);
+
+    if (!written) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't write profiler trace to %s: %s", path, SDL_GetError());
+        return;
+    }
+
+    SDL_Log("Wrote %zu profiler zones to %s", traceSize, path);
+}
+
+void Profiler::handleEvent(const SDL_Event& event) {
+    if (event.type != SDL_EVENT_KEY_DOWN || event.key.repeat) {
+        return;
+    }
+
+    if (event.key.key == SDLK_F3) {
+        setEnabled(!isEnabled());
+    } else if (event.key.key == SDLK_F4) {
+        this->view = this->view == View::ZONES ? View::WORST_FRAME : View::ZONES;
+    } else {
+        return;
+    }
+
+    // Refresh the text on the next render instead of waiting for the interval
+    this->refresh = true;
+}
+
+std::string Profiler::formatZones(const double usPerTick) {
+    const size_t count = zoneCount.load(std::memory_order_acquire);
+
+    size_t maxLen = 3;
+
+    for (size_t i = 0; i < count; i++) {
+        maxLen = std::max(maxLen, std::strlen(labels[i]));
+    }
+
+    const RenderStats::Counters render = lastFrame.render;
+
+    std::string text = std::format("{:<{}}: {:.2f}\n", "FPS", maxLen, this->fps);
+
+    text.append(std::format(
+        "Renderer: {} draw calls, {} vertices, {} texture binds, {} state changes\n",
+        render.drawCalls,
+        render.vertices,
+        render.textureBinds,
+        render.stateChanges));
+
+    this->rows.clear();
+    this->rows.push_back(NO_ZONE);
+    this->rows.push_back(NO_ZONE);
+
+    for (size_t i = 0; i < count; i++) {
+        const Stat& stat = stats[i];
+
+        if (stat.calls == 0) {
+            continue;
+        }
+
+        this->rows.push_back(static_cast<ZoneId>(i));
+
+        const Percentiles percentiles = getPercentiles(static_cast<ZoneId>(i));
+
+        text.append(std::format(
+            "{:<{}}: {:>8.2f} (avg: {:>8.2f}, p50: {:>8.2f}, p90: {:>8.2f}, p99: {:>8.2f}, p99.9: {:>8.2f}, max: {:>8.2f}",
+            labels[i],
+            maxLen,
+            static_cast<double>(stat.lastTicks) * usPerTick,
+            stat.avgTicks * usPerTick,
+            percentiles.p50,
+            percentiles.p90,
+            percentiles.p99,
+            percentiles.p999,
+            percentiles.max
+        ));
+
+        if constexpr (AllocationTracker::ENABLED) {
+            text.append(std::format(
+                ", allocs: {:>4} ({:>7} B), avg allocs: {:>6.1f}",
+                stat.lastAllocations,
+                stat.lastBytes,
+                stat.avgAllocations));
+        }
+
+        text.append(")\n");
+    }
+
+    for (const auto& [name, recorded, dropped]: getThreads()) {
+        text.append(std::format("Thread {}: {} zones, {} dropped\n", name, recorded, dropped));
+    }
+
+    return text;
+}
+
+std::string Profiler::formatWorstFrame(const double usPerTick) {
+    const uint64_t now = SDL_GetPerformanceCounter();
+    const uint64_t second = now / SDL_GetPerformanceFrequency();
+
+    const FrameCapture* worst = nullptr;
+
+    for (const FrameCapture& capture: captures) {
+        if (capture.ticks == 0 || second - capture.second >= WORST_FRAME_SECONDS) {
+            continue;
+        }
+
+        if (worst == nullptr || capture.ticks > worst->ticks) {
+            worst = &capture;
+        }
+    }
+
+    if (worst == nullptr) {
+        return "No frames captured\n";
+    }
+
+    const std::vector<ThreadInfo> threads = getThreads();
+
+    std::vector<ZoneEvent> events(worst->events.begin(), worst->events.begin() + worst->eventCount);
+
+    // Grouped by thread. Within a thread parents start no later than their children, ties are broken by depth
+    std::ranges::sort(events, [](const ZoneEvent& a, const ZoneEvent& b) {
+        if (a.thread != b.thread) {
+            return a.thread < b.thread;
+        }
+
+        return a.start != b.start ? a.start < b.start : a.depth < b.depth;
+    });
+
+    // Node 0 is the frame and its children are one node per thread. Repeated calls of a zone under the same parent are
+    // merged into one node
+    std::vector<TreeNode> nodes{
+        TreeNode{
+            .zone = NO_ZONE,
+            .thread = renderThread,
+            .depth = 0,
+            .calls = 1,
+            .inclusiveTicks = worst->ticks,
+            .childTicks = 0,
+            .allocations = 0,
+            .children = {},
+        },
+    };
+
+    struct OpenNode {
+        size_t node;
+        uint64_t end;
+    };
+
+    std::vector<OpenNode> open;
+    size_t renderThreadNode = 0;
+
+    for (const ZoneEvent& event: events) {
+        if (open.empty() || nodes[open.front().node].thread != event.thread) {
+            const size_t index = nodes.size();
+
+            nodes[0].children.push_back(index);
+            nodes.push_back(TreeNode{
+                .zone = NO_ZONE,
+                .thread = event.thread,
+                .depth = 1,
+                .calls = 0,
+                .inclusiveTicks = 0,
+                .childTicks = 0,
+                .allocations = 0,
+                .children = {},
+            });
+
+            if (event.thread == renderThread) {
+                renderThreadNode = index;
             }
+
+            open.assign(1, OpenNode{.node = index, .end = UINT64_MAX});
         }
 
-        std::string newText = std::format("{:<{}}: {:.2f}\n", "FPS", maxLen, this->fps);
+        while (open.size() > 1 && event.start >= open.back().end) {
+            open.pop_back();
+        }
+
+        const size_t parent = open.back().node;
+        size_t index = 0;
+
+        for (const size_t child: nodes[parent].children) {
+            if (nodes[child].zone == event.zone) {
+                index = child;
+                break;
+            }
+        }
 
-        for (const auto&[label, stat]: this->stats) {
-            newText.append(std::format(
-                "{:<{}}: {:>8.2f} (avg: {:>8.2f}, max: {:>8.2f})\n",
-                label,
+        if (index == 0) {
+            index = nodes.size();
+            nodes[parent].children.push_back(index);
+            nodes.push_back(TreeNode{
+                .zone = event.zone,
+                .thread = event.thread,
+                .depth = static_cast<uint16_t>(nodes[parent].depth + 1),
+                .calls = 0,
+                .inclusiveTicks = 0,
+                .childTicks = 0,
+                .allocations = 0,
+                .children = {},
+            });
+        }
+
+        const uint64_t ticks = event.end - event.start;
+
+        nodes[index].calls++;
+        nodes[index].inclusiveTicks += ticks;
+        nodes[index].allocations += event.allocations;
+        nodes[parent].childTicks += ticks;
+
+        open.push_back(OpenNode{.node = index, .end = event.end});
+    }
+
+    // Thread nodes only have the time of their top level zones
+    for (TreeNode& node: nodes) {
+        if (node.zone == NO_ZONE && node.depth == 1) {
+            node.inclusiveTicks = node.childTicks;
+        }
+    }
+
+    const auto getLabel = [&](const TreeNode& node) -> std::string {
+        if (node.zone != NO_ZONE) {
+            return labels[node.zone];
+        }
+
+        return node.thread < threads.size() ? threads[node.thread].name : std::format("Thread {}", node.thread);
+    };
+
+    size_t maxLen = 9;
+
+    for (size_t i = 1; i < nodes.size(); i++) {
+        maxLen = std::max(maxLen, (nodes[i].depth - 1) * 2 + getLabel(nodes[i]).size());
+    }
+
+    const double frequency = static_cast<double>(SDL_GetPerformanceFrequency());
+
+    std::string text = std::format(
+        "Worst frame in last {}s: {:.2f} ms ({:.1f}s ago)\n",
+        WORST_FRAME_SECONDS,
+        static_cast<double>(worst->ticks) * usPerTick / 1000.0,
+        static_cast<double>(now - worst->start) / frequency);
+
+    if constexpr (AllocationTracker::ENABLED) {
+        text.append(std::format("Render thread allocations: {}\n", worst->allocations));
+    }
+
+    text.append(std::format(
+        "Renderer: {} draw calls, {} vertices, {} texture binds, {} state changes\n",
+        worst->render.drawCalls,
+        worst->render.vertices,
+        worst->render.textureBinds,
+        worst->render.stateChanges));
+
+    text.append(std::format("{:<{}} {:>9} {:>9} {:>6}", "Zone", maxLen, "Incl us", "Self us", "Calls"));
+    text.append(AllocationTracker::ENABLED ? " Allocs\n" : "\n");
+
+    // Depth first walk with the most expensive children first
+    std::vector<size_t> pending;
+
+    auto pushChildren = [&](const size_t index) {
+        std::vector<size_t> children = nodes[index].children;
+
+        std::ranges::sort(children, [&](const size_t a, const size_t b) {
+            return nodes[a].inclusiveTicks < nodes[b].inclusiveTicks;
+        });
+
+        pending.insert(pending.end(), children.begin(), children.end());
+    };
+
+    pushChildren(0);
+
+    while (!pending.empty()) {
+        const size_t index = pending.back();
+        const TreeNode& node = nodes[index];
+
+        pending.pop_back();
+
+        if (node.zone == NO_ZONE) {
+            text.append(std::format(
+                "{:<{}} {:>9.2f}\n",
+                getLabel(node),
+                maxLen,
+                static_cast<double>(node.inclusiveTicks) * usPerTick));
+        } else {
+            text.append(std::format(
+                "{:<{}} {:>9.2f} {:>9.2f} {:>6}",
+                std::string((node.depth - 1) * 2, ' ') + getLabel(node),
                 maxLen,
-                stat.lastUs,
-                stat.avgUs,
-                stat.maxUs
-            ));
+                static_cast<double>(node.inclusiveTicks) * usPerTick,
+                static_cast<double>(node.inclusiveTicks - node.childTicks) * usPerTick,
+                node.calls));
+
+            if constexpr (AllocationTracker::ENABLED) {
+                text.append(std::format(" {:>6}", node.allocations));
+            }
+
+            text.append("\n");
+        }
+
+        pushChildren(index);
+    }
+
+    const uint64_t tracked = renderThreadNode != 0 ? nodes[renderThreadNode].inclusiveTicks : 0;
+
+    text.append(std::format(
+        "{:<{}} {:>9} {:>9.2f}\n",
+        "Untracked",
+        maxLen,
+        "",
+        static_cast<double>(worst->ticks - std::min(tracked, worst->ticks)) * usPerTick));
+
+    if (droppedEvents > 0) {
+        text.append(std::format("{} zone events dropped\n", droppedEvents));
+    }
+
+    return text;
+}
+
+void Profiler::render(const double deltaTime) {
+    this->frameCount++;
+    this->accumulator += deltaTime;
+
+    if (this->accumulator >= UPDATE_INTERVAL || this->refresh) {
+        // A hotkey can force a refresh before any time has accumulated, the previous rate stands until then
+        if (this->accumulator > 0.0) {
+            this->fps = static_cast<double>(this->frameCount) / this->accumulator;
+        }
+
+        const double usPerTick = 1'000'000.0 / this->freq;
+
+        std::string newText;
+
+        if (this->view == View::ZONES) {
+            newText = this->formatZones(usPerTick);
+        } else {
+            newText = formatWorstFrame(usPerTick);
+            this->rows.clear();
         }
 
         TTF_SetTextString(this->text, newText.c_str(), 0);
 
+        // Only lay the text out again when it changes
+        TTF_GetTextSize(this->text, &this->textWidth, &this->textHeight);
+
         this->frameCount = 0;
         this->accumulator = 0.0;
+        this->refresh = false;
+        overlayRefreshed = true;
     }
 
-    int w{};
-    int h{};
+    const auto rowHeight = static_cast<float>(TTF_GetFontLineSkip(this->font));
 
-    TTF_GetStringSizeWrapped(
-        this->font,
-        this->text->text, 0, 0, &w, &h);
+    this->buildGeometry(rowHeight);
 
-    const SDL_FRect bgRect{
-        .x = 0,
-        .y = 0,
-        .w = static_cast<float>(w) + PADDING * 2,
-        .h = static_cast<float>(h) + PADDING * 2
-    };
+    SDL_BlendMode blendMode{};
+    SDL_GetRenderDrawBlendMode(this->renderer, &blendMode);
+    RenderStats::setDrawBlendMode(this->renderer, SDL_BLENDMODE_BLEND);
+
+    RenderStats::renderGeometry(
+        this->renderer,
+        nullptr,
+        this->vertices.data(),
+        static_cast<int>(this->vertices.size()),
+        this->indices.data(),
+        static_cast<int>(this->vertices.size() / 4 * 6));
+
+    RenderStats::setDrawBlendMode(this->renderer, blendMode);
+
+    RenderStats::drawText(this->text, this->rect.x + PADDING + rowHeight, this->rect.y + PADDING);
+}
+
+void Profiler::addQuad(const SDL_FRect& rect, const SDL_FColor& color) {
+    const float right = rect.x + rect.w;
+    const float bottom = rect.y + rect.h;
+
+    this->vertices.push_back(SDL_Vertex{.position = {rect.x, rect.y}, .color = color, .tex_coord = {}});
+    this->vertices.push_back(SDL_Vertex{.position = {right, rect.y}, .color = color, .tex_coord = {}});
+    this->vertices.push_back(SDL_Vertex{.position = {right, bottom}, .color = color, .tex_coord = {}});
+    this->vertices.push_back(SDL_Vertex{.position = {rect.x, bottom}, .color = color, .tex_coord = {}});
+}
+
+void Profiler::buildGeometry(const float rowHeight) {
+    this->vertices.clear();
+
+    const float textLeft = this->rect.x + PADDING + rowHeight;
+    const float graphLeft = this->rect.x + PADDING;
+    const float graphTop = this->rect.y + PADDING * 2 + static_cast<float>(this->textHeight);
+    const float graphBottom = graphTop + GRAPH_HEIGHT;
+    const float width = std::max(rowHeight + static_cast<float>(this->textWidth), static_cast<float>(GRAPH_FRAMES));
+    const auto pixelsPerMs = static_cast<float>(GRAPH_HEIGHT / GRAPH_MAX_MS);
+
+    this->addQuad(
+        SDL_FRect{
+            .x = this->rect.x,
+            .y = this->rect.y,
+            .w = width + PADDING * 2,
+            .h = graphBottom + PADDING - this->rect.y,
+        },
+        BACKGROUND_COLOR.asFloat());
 
-    SDL_RenderTexture(this->renderer, this->background, nullptr, &bgRect);
-    TTF_DrawRendererText(this->text, this->rect.x + PADDING, this->rect.y + PADDING);
+    // Oldest frame on the left, every frame is one pixel wide and its zones are stacked bottom up
+    for (size_t i = 0; i < GRAPH_FRAMES; i++) {
+        const GraphFrame& frame = graph[(graphHead + i) % GRAPH_FRAMES];
+        const float x = graphLeft + static_cast<float>(i);
+
+        float y = graphBottom;
+        float trackedMs = 0.0f;
+
+        for (size_t series = 0; series < GRAPH_SERIES; series++) {
+            const float ms = frame.seriesMs[series];
+
+            if (ms <= 0.0f) {
+                continue;
+            }
+
+            const float height = std::min(ms * pixelsPerMs, y - graphTop);
+
+            this->addQuad(SDL_FRect{.x = x, .y = y - height, .w = 1.0f, .h = height}, SERIES_COLORS[series].asFloat());
+
+            y -= height;
+            trackedMs += ms;
+        }
+
+        if (const float untrackedMs = frame.frameMs - trackedMs; untrackedMs > 0.0f) {
+            const float height = std::min(untrackedMs * pixelsPerMs, y - graphTop);
+
+            this->addQuad(SDL_FRect{.x = x, .y = y - height, .w = 1.0f, .h = height}, UNTRACKED_COLOR.asFloat());
+        }
+    }
+
+    for (const double budget: GRAPH_BUDGETS_MS) {
+        const float y = graphBottom - static_cast<float>(budget) * pixelsPerMs;
+
+        this->addQuad(
+            SDL_FRect{.x = graphLeft, .y = y, .w = static_cast<float>(GRAPH_FRAMES), .h = 1.0f},
+            BUDGET_COLOR.asFloat());
+    }
+
+    // Colour swatches in front of the zone rows tie the text to the graph
+    const float swatchSize = rowHeight * 0.6f;
+
+    for (size_t row = 0; row < this->rows.size(); row++) {
+        if (this->rows[row] == NO_ZONE || !graphedZones[this->rows[row]]) {
+            continue;
+        }
+
+        const size_t series = std::min<size_t>(this->rows[row], GRAPH_SERIES - 1);
+
+        this->addQuad(
+            SDL_FRect{
+                .x = textLeft - rowHeight + (rowHeight - swatchSize) / 2.0f,
+                .y = this->rect.y + PADDING + static_cast<float>(row) * rowHeight + (rowHeight - swatchSize) / 2.0f,
+                .w = swatchSize,
+                .h = swatchSize,
+            },
+            SERIES_COLORS[series].asFloat());
+    }
 }
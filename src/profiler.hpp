@@ -1,53 +1,359 @@
 #pragma once
 
-#include <map>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
 
 #include <SDL3/SDL.h>
 
+#include "allocation_tracker.hpp"
+#include "histogram.hpp"
+#include "render_stats.hpp"
 #include "ui_component.hpp"
 
-#if SWEEPMINER_ENABLE_PROFILER
-#define ProfileCall(label, func) Profiler::getInstance().measure(label, [&] { func; });
-#else
-#define ProfileCall(label, func) func;
-#endif
+#define SWEEPMINER_PROFILE_CONCAT_INNER(a, b) a##b
+#define SWEEPMINER_PROFILE_CONCAT(a, b) SWEEPMINER_PROFILE_CONCAT_INNER(a, b)
+
+/**
+ * Times the rest of the enclosing scope. The zone is registered the first time the site runs and its ID is cached in a
+ * function local static. While the profiler is disabled every later pass costs a single flag check, while it is enabled
+ * it reads two performance counters and appends to the thread's buffer.
+ */
+#define ProfileScope(label)                                                                                            \
+    static const Profiler::ZoneId SWEEPMINER_PROFILE_CONCAT(profileZone, __LINE__) = Profiler::registerZone(label);   \
+    const Profiler::Scope SWEEPMINER_PROFILE_CONCAT(profileScope, __LINE__)(                                           \
+        SWEEPMINER_PROFILE_CONCAT(profileZone, __LINE__))
+
+#define ProfileCall(label, ...) { ProfileScope(label); __VA_ARGS__; }
 
 class Profiler {
 public:
+    using ZoneId = uint16_t;
+
+    static constexpr size_t MAX_ZONES = 128;
+    static constexpr size_t MAX_FRAME_EVENTS = 4096;
+    static constexpr size_t THREAD_BUFFER_CAPACITY = 4096;
+    static constexpr size_t WORST_FRAME_SECONDS = 5;
+    static constexpr size_t TRACE_CAPACITY = 1 << 16;
+    static constexpr size_t TRACE_FRAMES = 4096;
+    static constexpr size_t HISTOGRAM_SECONDS = 10;
+    static constexpr size_t HISTOGRAM_WINDOWS = 5;
+    static constexpr size_t MAX_DEPTH = 64;
     static constexpr double UPDATE_INTERVAL = 0.5;
     static constexpr float FONT_SIZE = 8.0;
     static constexpr float PADDING = 5.0;
 
-    explicit Profiler(SDL_Renderer* renderer, TTF_TextEngine* textEngine);
+    // The first GRAPH_SERIES - 1 zones get their own colour in the frame graph, the rest share the last one
+    static constexpr size_t GRAPH_FRAMES = 300;
+    static constexpr size_t GRAPH_SERIES = 8;
+    static constexpr float GRAPH_HEIGHT = 100.0;
+    static constexpr double GRAPH_MAX_MS = 33.3;
+    static constexpr std::array<double, 2> GRAPH_BUDGETS_MS = {16.6, 8.3};
+
+    class Scope {
+    public:
+        explicit Scope(const ZoneId zone)
+            : zone(zone),
+              active(Profiler::isEnabled()),
+              depth(0),
+              allocations(),
+              start(0) {
+            if (this->active) {
+                this->depth = Profiler::depth++;
+                this->allocations = AllocationTracker::getThreadCounters();
+                this->start = SDL_GetPerformanceCounter();
+            }
+        }
+
+        ~Scope() {
+            if (!this->active) {
+                return;
+            }
+
+            const uint64_t end = SDL_GetPerformanceCounter();
+            const AllocationTracker::Counters allocated = AllocationTracker::getThreadCounters();
+
+            Profiler::depth--;
+            Profiler::record(
+                this->zone,
+                this->depth,
+                this->start,
+                end,
+                allocated.allocations - this->allocations.allocations,
+                allocated.bytes - this->allocations.bytes);
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        ZoneId zone;
+        bool active;
+        uint16_t depth;
+        AllocationTracker::Counters allocations;
+        uint64_t start;
+    };
+
+    struct FrameStats {
+        uint64_t ticks;
+        uint64_t allocations;
+        uint64_t bytes;
+        RenderStats::Counters render;
+
+        // The overlay text was rebuilt this frame, which formats strings and builds the call tree on the heap
+        bool overlayRefreshed;
+    };
+
+    /**
+     * Latency percentiles of a zone over the last HISTOGRAM_SECONDS, in microseconds.
+     */
+    struct Percentiles {
+        uint64_t count;
+        double p50;
+        double p90;
+        double p99;
+        double p999;
+        double max;
+    };
+
+    struct ThreadInfo {
+        std::string name;
+        uint64_t recorded;
+        uint64_t dropped;
+    };
+
+    enum class View {
+        ZONES,
+        WORST_FRAME,
+    };
+
+    explicit Profiler(SDL_Renderer* renderer, TTF_TextEngine* textEngine, TTF_Font* font);
     ~Profiler();
 
     static Profiler& getInstance();
 
-    template <typename Func>
-    void measure(const char* label, Func&& func) {
-        const uint64_t start = SDL_GetPerformanceCounter();
-        func();
-        const uint64_t end = SDL_GetPerformanceCounter();
-
-        const double us = static_cast<double>(end - start) * 1'000'000.0 / freq;
-        auto&[lastUs, avgUs, maxUs, calls] = this->stats[label];
-        lastUs = us;
-        calls++;
-        maxUs = us > maxUs ? us : maxUs;
-        avgUs = calls == 1 ? us : avgUs * 0.9 + us * 0.1;
+    [[nodiscard]] static bool isEnabled() { return enabled.load(std::memory_order_relaxed); }
+    static void setEnabled(bool value);
+
+    /**
+     * Returns the ID for the given label, registering it on first use. Labels are compared by content so the same
+     * label used from different translation units shares one zone.
+     */
+    static ZoneId registerZone(const char* label);
+
+    [[nodiscard]] static size_t getZoneCount() { return zoneCount.load(std::memory_order_acquire); }
+    [[nodiscard]] static const char* getZoneLabel(const ZoneId zone) { return labels[zone]; }
+
+    /**
+     * Names the calling thread in the overlay and in traces. Threads that never call this are numbered.
+     */
+    static void setThreadName(const char* name);
+
+    [[nodiscard]] static std::vector<ThreadInfo> getThreads();
+
+    /**
+     * Appends a finished zone to the calling thread's buffer. Each thread owns its buffer and the render thread is the
+     * only reader, so recording never takes a lock. Zones are dropped while the buffer is full.
+     */
+    static void record(
+        const ZoneId zone,
+        const uint16_t depth,
+        const uint64_t start,
+        const uint64_t end,
+        const uint64_t allocations,
+        const uint64_t bytes) {
+        ThreadBuffer* buffer = threadBuffer;
+
+        if (buffer == nullptr) [[unlikely]] {
+            buffer = acquireThreadBuffer();
+        }
+
+        const size_t head = buffer->head.load(std::memory_order_relaxed);
+
+        if (head - buffer->tail.load(std::memory_order_acquire) < THREAD_BUFFER_CAPACITY) [[likely]] {
+            buffer->events[head % THREAD_BUFFER_CAPACITY] = ZoneEvent{
+                .zone = zone,
+                .thread = buffer->index,
+                .depth = depth,
+                .allocations = static_cast<uint32_t>(allocations),
+                .bytes = static_cast<uint32_t>(bytes),
+                .start = start,
+                .end = end,
+            };
+            buffer->head.store(head + 1, std::memory_order_release);
+        } else {
+            buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+        }
     }
 
+    /**
+     * Closes the current frame. Called once per iteration on the render thread after the outermost zone has ended.
+     * Drains every thread's buffer and folds the zones into the stats and histograms, and keeps frames slower than the
+     * slowest one already captured for the current second so the overlay can show where the time went.
+     */
+    static void endFrame();
+
+    [[nodiscard]] static Percentiles getPercentiles(ZoneId zone);
+
+    /**
+     * Latency percentiles of a zone over the calls recorded since the previous take, for reporting per interval
+     * without the overlap of the rolling window. Only collected after enableIntervalPercentiles.
+     */
+    [[nodiscard]] static Percentiles takeIntervalPercentiles(ZoneId zone);
+    static void enableIntervalPercentiles() { intervalPercentiles = true; }
+
+    /**
+     * The duration of the last completed frame and the allocations the render thread made during it. Allocations are
+     * only counted when built with SWEEPMINER_TRACK_ALLOCATIONS.
+     */
+    [[nodiscard]] static FrameStats getLastFrame() { return lastFrame; }
+
+    /**
+     * Leaves allocations the render thread made outside the frame proper, such as writing reports, out of the current
+     * frame's totals so they don't count against allocation budgets. Only call it on the render thread.
+     */
+    static void excludeAllocations(const AllocationTracker::Counters& excluded);
+
+    /**
+     * Writes the zones kept in the trace ring buffer as Chrome Trace Event JSON, loadable in Perfetto or
+     * chrome://tracing. The allocations of building the file are excluded from the frame.
+     */
+    static void writeTrace(const char* path);
+
+    void handleEvent(const SDL_Event& event);
     void render(double deltaTime);
 
 private:
     struct Stat {
-        double lastUs{0.0};
-        double avgUs{0.0};
-        double maxUs{0.0};
+        uint64_t lastTicks{0};
+        double avgTicks{0.0};
         uint64_t calls{0};
+        uint64_t lastAllocations{0};
+        uint64_t lastBytes{0};
+        double avgAllocations{0.0};
+    };
+
+    static constexpr size_t HISTOGRAM_WINDOW_SECONDS = HISTOGRAM_SECONDS / HISTOGRAM_WINDOWS;
+
+    /**
+     * One histogram per HISTOGRAM_WINDOW_SECONDS, reused round robin, so percentiles cover a rolling window. Windows
+     * are a few seconds long rather than one to keep the fine grained histograms to a bounded size per zone.
+     */
+    struct ZoneHistogram {
+        std::array<uint64_t, HISTOGRAM_WINDOWS> periods{};
+        std::array<Histogram, HISTOGRAM_WINDOWS> windows{};
+    };
+
+    static constexpr ZoneId NO_ZONE = UINT16_MAX;
+
+    struct ZoneEvent {
+        ZoneId zone;
+        uint16_t thread;
+        uint16_t depth;
+        uint32_t allocations;
+        uint32_t bytes;
+        uint64_t start;
+        uint64_t end;
+    };
+
+    /**
+     * A single producer, single consumer ring of finished zones. The owning thread advances head, the render thread
+     * advances tail. Buffers of threads that have exited are handed to the next new thread once they are drained.
+     */
+    struct ThreadBuffer {
+        uint16_t index{0};
+        std::string name{};
+        std::atomic<bool> active{false};
+        std::atomic<uint64_t> dropped{0};
+        uint64_t recorded{0};
+        alignas(64) std::atomic<size_t> head{0};
+        alignas(64) std::atomic<size_t> tail{0};
+        std::array<ZoneEvent, THREAD_BUFFER_CAPACITY> events{};
+    };
+
+    /**
+     * Renderer counters of a frame, written to the trace as counter events.
+     */
+    struct TraceFrame {
+        uint64_t start{0};
+        RenderStats::Counters render{};
+    };
+
+    struct FrameCapture {
+        uint64_t second{0};
+        uint64_t start{0};
+        uint64_t ticks{0};
+        uint64_t allocations{0};
+        RenderStats::Counters render{};
+        size_t eventCount{0};
+        std::array<ZoneEvent, MAX_FRAME_EVENTS> events{};
+    };
+
+    /**
+     * Self time of the render thread's zones during one frame, grouped into graph series.
+     */
+    struct GraphFrame {
+        float frameMs;
+        std::array<float, GRAPH_SERIES> seriesMs;
+    };
+
+    // Background, stacked bars plus the untracked remainder for every frame, budget lines and one swatch per zone
+    static constexpr size_t MAX_QUADS = 1 + GRAPH_FRAMES * (GRAPH_SERIES + 1) + GRAPH_BUDGETS_MS.size() + MAX_ZONES;
+
+    struct TreeNode {
+        ZoneId zone;
+        uint16_t thread;
+        uint16_t depth;
+        uint32_t calls;
+        uint64_t inclusiveTicks;
+        uint64_t childTicks;
+        uint64_t allocations;
+        std::vector<size_t> children;
     };
 
     static Profiler* instance;
+    static std::atomic<bool> enabled;
+    static bool wasEnabled;
+
+    static std::array<const char*, MAX_ZONES> labels;
+    static std::atomic<size_t> zoneCount;
+    static std::array<Stat, MAX_ZONES> stats;
+    static std::array<ZoneHistogram, MAX_ZONES> histograms;
+    static bool intervalPercentiles;
+    static std::array<Histogram, MAX_ZONES> intervalHistograms;
+
+    static thread_local uint16_t depth;
+    static thread_local ThreadBuffer* threadBuffer;
+    static std::vector<std::unique_ptr<ThreadBuffer>> threadBuffers;
+    static uint16_t renderThread;
+    static std::array<ZoneEvent, MAX_FRAME_EVENTS> frameEvents;
+    static size_t frameEventCount;
+    static uint64_t droppedEvents;
+    static uint64_t frameStart;
+    static AllocationTracker::Counters frameAllocations;
+    static FrameStats lastFrame;
+    static bool overlayRefreshed;
+    static std::array<FrameCapture, WORST_FRAME_SECONDS> captures;
+    static std::array<ZoneEvent, TRACE_CAPACITY> trace;
+    static size_t traceHead;
+    static size_t traceSize;
+    static std::array<TraceFrame, TRACE_FRAMES> traceFrames;
+    static size_t traceFrameHead;
+    static size_t traceFrameSize;
+    static std::array<GraphFrame, GRAPH_FRAMES> graph;
+    static std::array<bool, MAX_ZONES> graphedZones;
+    static size_t graphHead;
+
+    static ThreadBuffer* acquireThreadBuffer();
+    static void drainThreads();
+    static void appendTrace(const ZoneEvent& event);
+    static void writeTraceFile(const char* path);
+    static void updateZone(const ZoneEvent& event, uint64_t second, double nsPerTick);
+    static Percentiles toPercentiles(const Histogram& histogram);
+    static void updateGraph(uint64_t frameTicks, double msPerTick);
 
     SDL_Renderer* renderer;
     TTF_TextEngine* textEngine;
@@ -57,9 +363,23 @@ private:
     double accumulator;
     uint64_t frameCount;
     double fps;
-    std::map<const char *, Stat> stats;
+    View view;
+    bool refresh;
 
-    SDL_Texture* background;
     TTF_Font* font;
     TTF_Text* text;
+    int textWidth;
+    int textHeight;
+
+    // The zone shown on each line of the text, used to place the graph colour swatches
+    std::vector<ZoneId> rows;
+
+    std::vector<SDL_Vertex> vertices;
+    std::vector<int> indices;
+
+    void addQuad(const SDL_FRect& rect, const SDL_FColor& color);
+    void buildGeometry(float rowHeight);
+
+    [[nodiscard]] std::string formatZones(double usPerTick);
+    [[nodiscard]] static std::string formatWorstFrame(double usPerTick);
 };
@@ -0,0 +1,170 @@
+#include "render_bench.hpp"
+
+#include <format>
+
+#include <SDL3/SDL.h>
+
+#include "metrics_csv.hpp"
+#include "profiler.hpp"
+
+const std::array<RenderBench::Scene, 8> RenderBench::SCENES = {{
+    {.name = "expert_hidden", .rows = 16, .columns = 30, .mines = 99, .played = 0.0f, .zoom = 1.0f, .allNumbers = false},
+    {.name = "expert_half_played", .rows = 16, .columns = 30, .mines = 99, .played = 0.5f, .zoom = 1.0f, .allNumbers = false},
+    {.name = "expert_all_numbers", .rows = 16, .columns = 30, .mines = 0, .played = 1.0f, .zoom = 1.0f, .allNumbers = true},
+    {.name = "custom_64x64_x1", .rows = 64, .columns = 64, .mines = 255, .played = 0.5f, .zoom = 1.0f, .allNumbers = false},
+    {.name = "custom_64x64_x2", .rows = 64, .columns = 64, .mines = 255, .played = 0.5f, .zoom = 2.0f, .allNumbers = false},
+    {.name = "custom_64x64_x3", .rows = 64, .columns = 64, .mines = 255, .played = 0.5f, .zoom = 3.0f, .allNumbers = false},
+    {.name = "custom_128x128_x1", .rows = 128, .columns = 128, .mines = 255, .played = 0.5f, .zoom = 1.0f, .allNumbers = false},
+    {.name = "custom_128x128_x2", .rows = 128, .columns = 128, .mines = 255, .played = 0.5f, .zoom = 2.0f, .allNumbers = false},
+}};
+
+RenderBench::RenderBench(Game& game, const uint64_t frames) : game(game), frames(frames) {}
+
+bool RenderBench::run(const FrameCallback& renderFrame, const std::string& csvPath) {
+    std::vector<Result> results;
+
+    results.reserve(SCENES.size());
+
+    SDL_Log("Render bench: %" SDL_PRIu64 " frames per scene on the %s renderer",
+            this->frames,
+            SDL_GetRendererName(this->game.getContext().getRenderer()));
+
+    for (const Scene& scene: SCENES) {
+        const Result& result = results.emplace_back(this->runScene(scene, renderFrame));
+
+        SDL_Log("%-20s p50 %8.3f ms  p90 %8.3f ms  p99 %8.3f ms  max %8.3f ms  "
+                "%u draw calls, %u vertices, %u texture binds, %u state changes",
+                result.scene.c_str(),
+                static_cast<double>(result.frameTimes.getPercentile(50.0)) / 1'000'000.0,
+                static_cast<double>(result.frameTimes.getPercentile(90.0)) / 1'000'000.0,
+                static_cast<double>(result.frameTimes.getPercentile(99.0)) / 1'000'000.0,
+                static_cast<double>(result.frameTimes.getMax()) / 1'000'000.0,
+                result.render.drawCalls,
+                result.render.vertices,
+                result.render.textureBinds,
+                result.render.stateChanges);
+    }
+
+    return csvPath.empty() || writeCsv(csvPath, results);
+}
+
+std::unique_ptr<Board> RenderBench::createBoard(const Scene& scene) {
+    std::unique_ptr<Board> board = scene.allNumbers
+        ? std::make_unique<Board>(scene.rows, scene.columns, createAllNumbersLayout(scene.rows, scene.columns))
+        : std::make_unique<Board>(scene.rows, scene.columns, scene.mines, this->generator);
+
+    const auto cells = static_cast<size_t>(scene.rows) * scene.columns;
+    const auto played = static_cast<size_t>(static_cast<float>(cells) * scene.played);
+
+    for (size_t i = 0; i < played; i++) {
+        const auto row = static_cast<uint8_t>(i / scene.columns);
+        const auto column = static_cast<uint8_t>(i % scene.columns);
+
+        if (board->getState(row, column) != Board::CellState::HIDDEN) {
+            continue;
+        }
+
+        if (board->hasMine(row, column)) {
+            board->cycleMark(row, column);
+        } else {
+            board->reveal(row, column);
+        }
+    }
+
+    // Nobody plays the sounds or pushes the SDL events of setting the scene up
+    BoardEvent event{};
+    while (board->pollEvent(event)) {}
+
+    return board;
+}
+
+RenderBench::Result RenderBench::runScene(const Scene& scene, const FrameCallback& renderFrame) {
+    SDL_Window* window = this->game.getContext().getWindow();
+    SDL_Renderer* renderer = this->game.getContext().getRenderer();
+
+    this->game.newGame(this->createBoard(scene));
+
+    // Zooming scales the whole frame up in the renderer, so the window grows with it
+    int width = 0;
+    int height = 0;
+
+    SDL_GetWindowSize(window, &width, &height);
+    SDL_SetWindowSize(
+        window,
+        static_cast<int>(static_cast<float>(width) * scene.zoom),
+        static_cast<int>(static_cast<float>(height) * scene.zoom));
+    SDL_SetRenderScale(renderer, scene.zoom, scene.zoom);
+
+    Result result{.scene = scene.name, .frameTimes = {}, .render = {}};
+
+    const uint64_t frequency = SDL_GetPerformanceFrequency();
+
+    // The first frames of a scene upload textures and resize the window's surface
+    for (uint64_t i = 0; i < WARMUP_FRAMES + this->frames; i++) {
+        renderFrame();
+        Profiler::endFrame();
+
+        if (i < WARMUP_FRAMES) {
+            continue;
+        }
+
+        const Profiler::FrameStats frame = Profiler::getLastFrame();
+
+        result.frameTimes.record(frame.ticks * 1'000'000'000 / frequency);
+        result.render = frame.render;
+    }
+
+    SDL_SetRenderScale(renderer, 1.0f, 1.0f);
+
+    return result;
+}
+
+std::vector<uint8_t> RenderBench::createAllNumbersLayout(const uint8_t rows, const uint8_t columns) {
+    constexpr std::array<std::pair<int, int>, 8> NEIGHBOURS = {{
+        {-1, -1}, {-1, +0}, {-1, +1}, {+0, +1}, {+1, +1}, {+1, +0}, {+1, -1}, {+0, -1},
+    }};
+
+    std::vector<uint8_t> mineCells(static_cast<size_t>(rows) * columns, 0);
+
+    if (rows < 3) {
+        return mineCells;
+    }
+
+    // A cell with the first count neighbours mined for every count, spaced so their neighbourhoods don't overlap
+    for (int count = 1; count <= 8; count++) {
+        const int column = 1 + (count - 1) * 3;
+
+        if (column + 1 >= columns) {
+            break;
+        }
+
+        for (int i = 0; i < count; i++) {
+            const auto [deltaRow, deltaColumn] = NEIGHBOURS[i];
+
+            mineCells[static_cast<size_t>(1 + deltaRow) * columns + static_cast<size_t>(column + deltaColumn)] = 1;
+        }
+    }
+
+    return mineCells;
+}
+
+bool RenderBench::writeCsv(const std::string& path, const std::vector<Result>& results) {
+    MetricsCsv csv;
+
+    const auto append = [&csv](const std::string& scene, const char* metric, const double value) {
+        csv.append(0.0, std::format("render_bench.{}.{}", scene, metric), value);
+    };
+
+    for (const Result& result: results) {
+        append(result.scene, "p50_us", static_cast<double>(result.frameTimes.getPercentile(50.0)) / 1000.0);
+        append(result.scene, "p90_us", static_cast<double>(result.frameTimes.getPercentile(90.0)) / 1000.0);
+        append(result.scene, "p99_us", static_cast<double>(result.frameTimes.getPercentile(99.0)) / 1000.0);
+        append(result.scene, "max_us", static_cast<double>(result.frameTimes.getMax()) / 1000.0);
+        append(result.scene, "draw_calls", result.render.drawCalls);
+        append(result.scene, "vertices", result.render.vertices);
+        append(result.scene, "texture_binds", result.render.textureBinds);
+        append(result.scene, "state_changes", result.render.stateChanges);
+    }
+
+    return csv.save(path);
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "board.hpp"
+#include "game.hpp"
+#include "histogram.hpp"
+#include "render_stats.hpp"
+
+/**
+ * Replays fixed scenes through the game's real render path for a number of frames each and reports the frame time
+ * distribution and renderer counters of every scene. Run under SDL's offscreen video driver with the software renderer
+ * it gives numbers that can be compared between renderer changes without a display.
+ */
+class RenderBench {
+public:
+    struct Result {
+        std::string scene;
+        Histogram frameTimes;
+        RenderStats::Counters render;
+    };
+
+    /**
+     * Renders and presents one frame exactly as the main loop does.
+     */
+    using FrameCallback = std::function<void()>;
+
+    explicit RenderBench(Game& game, uint64_t frames);
+
+    /**
+     * Renders every scene, logs a report and writes it as metrics CSV when a path is given. Returns false if the CSV
+     * couldn't be written.
+     */
+    bool run(const FrameCallback& renderFrame, const std::string& csvPath);
+
+private:
+    static constexpr uint64_t WARMUP_FRAMES = 10;
+    static constexpr uint32_t SEED = 0x5eed;
+
+    struct Scene {
+        const char* name;
+        uint8_t rows;
+        uint8_t columns;
+        uint8_t mines;
+
+        /**
+         * How much of the board, in row major order, is played through before rendering. Mines on the way are
+         * flagged and every other hidden cell is revealed.
+         */
+        float played;
+
+        float zoom;
+
+        /**
+         * Lays mines out so every number from 1 to 8 shows up instead of placing them at random.
+         */
+        bool allNumbers;
+    };
+
+    static const std::array<Scene, 8> SCENES;
+
+    Game& game;
+    uint64_t frames;
+    std::mt19937 generator{SEED};
+
+    std::unique_ptr<Board> createBoard(const Scene& scene);
+    Result runScene(const Scene& scene, const FrameCallback& renderFrame);
+
+    static std::vector<uint8_t> createAllNumbersLayout(uint8_t rows, uint8_t columns);
+    static bool writeCsv(const std::string& path, const std::vector<Result>& results);
+};
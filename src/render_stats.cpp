@@ -0,0 +1,17 @@
+#include "render_stats.hpp"
+
+RenderStats::Counters RenderStats::counters{};
+RenderStats::Counters RenderStats::lastFrame{};
+SDL_Texture* RenderStats::lastTexture = nullptr;
+uint32_t RenderStats::lastColor = 0;
+SDL_BlendMode RenderStats::lastBlendMode = SDL_BLENDMODE_NONE;
+
+RenderStats::Counters RenderStats::endFrame() {
+    lastFrame = counters;
+    counters = Counters{};
+    lastTexture = nullptr;
+    lastColor = 0;
+    lastBlendMode = SDL_BLENDMODE_NONE;
+
+    return lastFrame;
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstdint>
+
+#include <SDL3/SDL.h>
+#include <SDL3_ttf/SDL_ttf.h>
+
+/**
+ * Thin wrappers around the SDL render calls the game makes that count what is submitted to the renderer each frame.
+ * Texture binds and state changes are only counted when they differ from the previous call, since those are what
+ * break SDL's batching.
+ */
+class RenderStats {
+public:
+    struct Counters {
+        uint32_t drawCalls{0};
+        uint32_t vertices{0};
+        uint32_t textureBinds{0};
+        uint32_t stateChanges{0};
+    };
+
+    static bool clear(SDL_Renderer* renderer) {
+        counters.drawCalls++;
+
+        return SDL_RenderClear(renderer);
+    }
+
+    static bool renderTexture(
+        SDL_Renderer* renderer,
+        SDL_Texture* texture,
+        const SDL_FRect* source,
+        const SDL_FRect* destination) {
+        bindTexture(texture);
+
+        counters.drawCalls++;
+        counters.vertices += 4;
+
+        return SDL_RenderTexture(renderer, texture, source, destination);
+    }
+
+    static bool renderGeometry(
+        SDL_Renderer* renderer,
+        SDL_Texture* texture,
+        const SDL_Vertex* vertices,
+        const int vertexCount,
+        const int* indices,
+        const int indexCount) {
+        bindTexture(texture);
+
+        counters.drawCalls++;
+        counters.vertices += static_cast<uint32_t>(indices != nullptr ? indexCount : vertexCount);
+
+        return SDL_RenderGeometry(renderer, texture, vertices, vertexCount, indices, indexCount);
+    }
+
+    static bool renderFillRect(SDL_Renderer* renderer, const SDL_FRect* rect) {
+        bindTexture(nullptr);
+
+        counters.drawCalls++;
+        counters.vertices += 4;
+
+        return SDL_RenderFillRect(renderer, rect);
+    }
+
+    static bool renderLine(SDL_Renderer* renderer, const float x1, const float y1, const float x2, const float y2) {
+        bindTexture(nullptr);
+
+        counters.drawCalls++;
+        counters.vertices += 2;
+
+        return SDL_RenderLine(renderer, x1, y1, x2, y2);
+    }
+
+    /**
+     * Text is drawn from the font atlas, its vertices are generated inside SDL_ttf and aren't counted.
+     */
+    static bool drawText(TTF_Text* text, const float x, const float y) {
+        counters.drawCalls++;
+        lastTexture = nullptr;
+
+        return TTF_DrawRendererText(text, x, y);
+    }
+
+    static bool setDrawColor(SDL_Renderer* renderer, const uint8_t r, const uint8_t g, const uint8_t b, const uint8_t a) {
+        const uint32_t color = static_cast<uint32_t>(r) << 24 | static_cast<uint32_t>(g) << 16 |
+                               static_cast<uint32_t>(b) << 8 | static_cast<uint32_t>(a);
+
+        if (color != lastColor) {
+            lastColor = color;
+            counters.stateChanges++;
+        }
+
+        return SDL_SetRenderDrawColor(renderer, r, g, b, a);
+    }
+
+    static bool setDrawBlendMode(SDL_Renderer* renderer, const SDL_BlendMode blendMode) {
+        if (blendMode != lastBlendMode) {
+            lastBlendMode = blendMode;
+            counters.stateChanges++;
+        }
+
+        return SDL_SetRenderDrawBlendMode(renderer, blendMode);
+    }
+
+    /**
+     * Closes the frame, returning its counters and starting the next one from zero. The last bound texture, colour and
+     * blend mode are forgotten too, so a frame's counts don't depend on how the previous one ended.
+     */
+    static Counters endFrame();
+
+    [[nodiscard]] static Counters getLastFrame() { return lastFrame; }
+
+private:
+    static Counters counters;
+    static Counters lastFrame;
+    static SDL_Texture* lastTexture;
+    static uint32_t lastColor;
+    static SDL_BlendMode lastBlendMode;
+
+    static void bindTexture(SDL_Texture* texture) {
+        if (texture != lastTexture) {
+            lastTexture = texture;
+            counters.textureBinds++;
+        }
+    }
+};
@@ -1,76 +1,199 @@
 #include "resource_manager.hpp"
 
-#include <ranges>
+#include <algorithm>
+#include <chrono>
 
 #include <SDL3_mixer/SDL_mixer.h>
 #include <SDL3_image/SDL_image.h>
 
+#include "assets.hpp"
+#include "profiler.hpp"
+
 ResourceManager::ResourceManager(SDL_Window* window, SDL_Renderer* renderer, MIX_Mixer* mixer)
     : window(window),
       renderer(renderer),
-      mixer(mixer) {}
+      mixer(mixer),
+      displayScale(SDL_GetWindowDisplayScale(window)) {}
 
 ResourceManager::~ResourceManager() {
-    for (const auto &texture: this->textures | std::views::values) {
+    // Let in-flight decodes finish so their buffers can be released
+    for (PendingTexture& pending: this->pendingTextures) {
+        SDL_DestroySurface(pending.surface.get());
+    }
+
+    for (PendingSound& pending: this->pendingSounds) {
+        SDL_free(pending.decoded.get().data);
+    }
+
+    for (SDL_Texture* texture: this->textures) {
         SDL_DestroyTexture(texture);
     }
 
-    for (const auto &sound: this->sounds | std::views::values) {
+    for (MIX_Audio* sound: this->sounds) {
         MIX_DestroyAudio(sound);
     }
 
-    for (const auto &font: this->fonts | std::views::values) {
-        TTF_CloseFont(font);
+    for (const std::vector<CachedFont>& sizes: this->fonts) {
+        for (const auto& [bucket, font]: sizes) {
+            TTF_CloseFont(font);
+        }
     }
 }
 
-void ResourceManager::loadTexture(const Texture texture, const char *path) {
-    if (this->textures.contains(texture)) {
+void ResourceManager::queueTexture(const Texture texture, const char *path) {
+    if (this->textures[static_cast<size_t>(texture)] != nullptr) {
         SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Texture '%s' already loaded", path);
         return;
     }
 
-    SDL_Texture* sdlTexture = IMG_LoadTexture(this->renderer, path);
+    if (std::ranges::any_of(this->pendingTextures, [texture](const PendingTexture& pending) {
+        return pending.texture == texture;
+    })) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Texture '%s' already queued", path);
+        return;
+    }
+
+    this->pendingTextures.push_back(PendingTexture{
+        .texture = texture,
+        .path = path,
+        .surface = std::async(std::launch::async, [path = std::string(path)] {
+            Profiler::setThreadName("Texture Loader");
+
+            ProfileScope("Decode Texture");
+
+            return IMG_Load_IO(Assets::open(path.c_str()), true);
+        }),
+    });
+}
+
+void ResourceManager::queueSound(const Sound sound, const char *path) {
+    if (this->sounds[static_cast<size_t>(sound)] != nullptr) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Sound '%s' already loaded", path);
+        return;
+    }
+
+    if (std::ranges::any_of(this->pendingSounds, [sound](const PendingSound& pending) {
+        return pending.sound == sound;
+    })) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Sound '%s' already queued", path);
+        return;
+    }
+
+    this->pendingSounds.push_back(PendingSound{
+        .sound = sound,
+        .path = path,
+        .decoded = std::async(std::launch::async, [path = std::string(path)] {
+            Profiler::setThreadName("Sound Loader");
+
+            ProfileScope("Decode Sound");
+
+            DecodedSound decoded{};
+
+            if (!SDL_LoadWAV_IO(Assets::open(path.c_str()), true, &decoded.spec, &decoded.data, &decoded.length)) {
+                decoded.data = nullptr;
+            }
+
+            return decoded;
+        }),
+    });
+}
+
+void ResourceManager::waitForTextures() {
+    for (PendingTexture& pending: this->pendingTextures) {
+        this->registerTexture(pending);
+    }
+
+    this->pendingTextures.clear();
+}
+
+void ResourceManager::update() {
+    if (!this->isLoading()) {
+        return;
+    }
+
+    std::erase_if(this->pendingTextures, [this](PendingTexture& pending) {
+        if (pending.surface.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            return false;
+        }
+
+        this->registerTexture(pending);
+
+        return true;
+    });
+
+    std::erase_if(this->pendingSounds, [this](PendingSound& pending) {
+        if (pending.decoded.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            return false;
+        }
+
+        this->registerSound(pending);
+
+        return true;
+    });
+}
+
+void ResourceManager::registerTexture(PendingTexture& pending) {
+    SDL_Surface* surface = pending.surface.get();
+
+    if (!surface) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Could not load texture: %s", pending.path.c_str());
+        return;
+    }
+
+    SDL_Texture* sdlTexture = SDL_CreateTextureFromSurface(this->renderer, surface);
+    SDL_DestroySurface(surface);
 
     if (!sdlTexture) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Could not load texture: %s", path);
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Could not upload texture: %s", pending.path.c_str());
         return;
     }
 
-    SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "Loaded texture: %s", path);
+    SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "Loaded texture: %s", pending.path.c_str());
 
     SDL_SetTextureScaleMode(sdlTexture, SDL_SCALEMODE_NEAREST);
 
-    this->textures[texture] = sdlTexture;
+    this->textures[static_cast<size_t>(pending.texture)] = sdlTexture;
 }
 
-void ResourceManager::loadSound(const Sound sound, const char *path) {
-    if (this->sounds.contains(sound)) {
-        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Sound '%s' already loaded", path);
+void ResourceManager::registerSound(PendingSound& pending) {
+    const auto [spec, data, length] = pending.decoded.get();
+
+    if (!data) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Could not load sound: %s", pending.path.c_str());
         return;
     }
 
-    MIX_Audio* sdlSound = MIX_LoadAudio(this->mixer, path, false);
+    // The mixer takes ownership of the decoded PCM and frees it with the audio
+    MIX_Audio* sdlSound = MIX_LoadRawAudioNoCopy(this->mixer, data, length, &spec, true);
 
     if (!sdlSound) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Could not load sound: %s", path);
+        SDL_free(data);
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Could not register sound: %s", pending.path.c_str());
         return;
     }
 
-    SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "Loaded sound: %s", path);
+    SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "Loaded sound: %s", pending.path.c_str());
+
+    this->sounds[static_cast<size_t>(pending.sound)] = sdlSound;
 
-    this->sounds[sound] = sdlSound;
+    if (this->onSoundLoaded) {
+        this->onSoundLoaded(pending.sound, sdlSound);
+    }
 }
 
-void ResourceManager::loadFont(Font font, const char *path, const float size) {
-    const float scaledSize = size * SDL_GetWindowDisplayScale(this->window);
+void ResourceManager::loadFont(const Font font, const char *path, const float size) {
+    const float scaledSize = size * this->displayScale;
+    const uint16_t bucket = this->getFontBucket(size);
+    std::vector<CachedFont>& sizes = this->fonts[static_cast<size_t>(font)];
 
-    if (this->fonts.contains({font, scaledSize})) {
-        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Font '%s' of size '%f' already loaded", path, size);
-        return;
+    for (const CachedFont& cached: sizes) {
+        if (cached.bucket == bucket) {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Font '%s' of size '%f' already loaded", path, size);
+            return;
+        }
     }
 
-    TTF_Font* sdlFont = TTF_OpenFont(path, scaledSize);
+    TTF_Font* sdlFont = TTF_OpenFontIO(Assets::open(path), true, scaledSize);
     if (!sdlFont) {
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Could not load font: %s", path);
         return;
@@ -78,25 +201,21 @@ void ResourceManager::loadFont(Font font, const char *path, const float size) {
 
     SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "Loaded font: %s @ %.1fpt (%.1fpt)", path, size, scaledSize);
 
-    this->fonts[{font, scaledSize}] = sdlFont;
-}
-
-SDL_Texture *ResourceManager::getTexture(const Texture texture) const {
-    if (const auto it = this->textures.find(texture); it != this->textures.end()) return it->second;
-    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Texture not found: %d", texture);
-    return nullptr;
-}
-
-MIX_Audio *ResourceManager::getSound(const Sound sound) const {
-    if (const auto it = this->sounds.find(sound); it != this->sounds.end()) return it->second;
-    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Sound not found: %d", sound);
-    return nullptr;
+    sizes.push_back(CachedFont{
+        .bucket = bucket,
+        .font = sdlFont,
+    });
 }
 
 TTF_Font *ResourceManager::getFont(const Font font, const float size) const {
-    const float scaledSize = size * SDL_GetWindowDisplayScale(this->window);
+    const uint16_t bucket = this->getFontBucket(size);
+
+    for (const CachedFont& cached: this->fonts[static_cast<size_t>(font)]) {
+        if (cached.bucket == bucket) {
+            return cached.font;
+        }
+    }
 
-    if (const auto it = this->fonts.find({font, scaledSize}); it != this->fonts.end()) return it->second;
-    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Font not found: %d @ %.1fpt (%.1fpt)", font, size, scaledSize);
+    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Font not found: %d @ %.1fpt (%.1fpt)", font, size, size * this->displayScale);
     return nullptr;
 }
@@ -1,51 +1,147 @@
 #pragma once
 
-#include <unordered_map>
+#include <array>
+#include <cmath>
+#include <functional>
+#include <future>
+#include <string>
+#include <vector>
 
 #include <SDL3/SDL.h>
 #include <SDL3_mixer/SDL_mixer.h>
 #include <SDL3_ttf/SDL_ttf.h>
 
-#include "pair_hash.hpp"
-
 class ResourceManager {
 public:
     enum class Texture {
         CELL,
         NUMBERS,
         SMILEY,
+        COUNT,
     };
 
     enum class Sound {
         CLICK,
         FLAG,
         EXPLODE,
+        COUNT,
     };
 
     enum class Font {
         NF_PIXELS,
         SOURCE_CODE_PRO,
+        COUNT,
     };
 
+    static constexpr size_t TEXTURE_COUNT = static_cast<size_t>(Texture::COUNT);
+    static constexpr size_t SOUND_COUNT = static_cast<size_t>(Sound::COUNT);
+    static constexpr size_t FONT_COUNT = static_cast<size_t>(Font::COUNT);
+
+    /**
+     * Font sizes are cached in buckets of 1/FONT_SIZE_BUCKETS of a point.
+     */
+    static constexpr float FONT_SIZE_BUCKETS = 4.0f;
+
     explicit ResourceManager(SDL_Window* window, SDL_Renderer* renderer, MIX_Mixer* mixer);
     ~ResourceManager();
 
     ResourceManager(const ResourceManager&) = delete;
     ResourceManager& operator=(const ResourceManager&) = delete;
 
-    [[nodiscard]] SDL_Texture* getTexture(Texture texture) const;
-    [[nodiscard]] MIX_Audio* getSound(Sound sound) const;
+    // Lookups are plain array reads. A resource's handle never changes once it is registered, so components are free to
+    // cache the returned pointers for the lifetime of the manager.
+
+    [[nodiscard]] SDL_Texture* getTexture(const Texture texture) const {
+        SDL_Texture* sdlTexture = this->textures[static_cast<size_t>(texture)];
+
+        if (sdlTexture == nullptr) [[unlikely]] {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Texture not found: %d", texture);
+        }
+
+        return sdlTexture;
+    }
+
+    [[nodiscard]] MIX_Audio* getSound(const Sound sound) const {
+        MIX_Audio* sdlSound = this->sounds[static_cast<size_t>(sound)];
+
+        if (sdlSound == nullptr) [[unlikely]] {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Sound not found: %d", sound);
+        }
+
+        return sdlSound;
+    }
+
     [[nodiscard]] TTF_Font* getFont(Font font, float size) const;
 
-    void loadTexture(Texture texture, const char* path);
-    void loadSound(Sound sound, const char* path);
+    /**
+     * Starts decoding the PNG at the given path on a worker thread. The texture is uploaded and becomes available
+     * through getTexture() once waitForTextures() or update() picks it up on the render thread.
+     */
+    void queueTexture(Texture texture, const char* path);
+
+    /**
+     * Starts decoding the WAV at the given path to PCM on a worker thread. The sound is registered by update() on the
+     * render thread, after which the sound loaded callback is invoked.
+     */
+    void queueSound(Sound sound, const char* path);
+
     void loadFont(Font font, const char* path, float size);
 
+    /**
+     * Blocks until every queued texture has been decoded, then uploads them.
+     */
+    void waitForTextures();
+
+    /**
+     * Registers any queued resources that have finished decoding without blocking. Must be called from the render
+     * thread.
+     */
+    void update();
+
+    [[nodiscard]] bool isLoading() const { return !this->pendingTextures.empty() || !this->pendingSounds.empty(); }
+
+    void setSoundLoadedCallback(const std::function<void(Sound, MIX_Audio*)>& callback) { this->onSoundLoaded = callback; }
+
 private:
+    struct CachedFont {
+        uint16_t bucket;
+        TTF_Font* font;
+    };
+
+    struct DecodedSound {
+        SDL_AudioSpec spec{};
+        Uint8* data{nullptr};
+        Uint32 length{0};
+    };
+
+    struct PendingTexture {
+        Texture texture;
+        std::string path;
+        std::future<SDL_Surface*> surface;
+    };
+
+    struct PendingSound {
+        Sound sound;
+        std::string path;
+        std::future<DecodedSound> decoded;
+    };
+
     SDL_Window* window;
     SDL_Renderer* renderer;
     MIX_Mixer* mixer;
-    std::unordered_map<Texture, SDL_Texture*> textures;
-    std::unordered_map<Sound, MIX_Audio*> sounds;
-    std::unordered_map<std::pair<Font, float>, TTF_Font*, PairHash> fonts;
+    float displayScale;
+    std::array<SDL_Texture*, TEXTURE_COUNT> textures{};
+    std::array<MIX_Audio*, SOUND_COUNT> sounds{};
+    std::array<std::vector<CachedFont>, FONT_COUNT> fonts{};
+
+    std::vector<PendingTexture> pendingTextures;
+    std::vector<PendingSound> pendingSounds;
+    std::function<void(Sound, MIX_Audio*)> onSoundLoaded;
+
+    [[nodiscard]] uint16_t getFontBucket(const float size) const {
+        return static_cast<uint16_t>(std::lround(size * this->displayScale * FONT_SIZE_BUCKETS));
+    }
+
+    void registerTexture(PendingTexture& pending);
+    void registerSound(PendingSound& pending);
 };
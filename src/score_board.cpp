@@ -36,8 +36,8 @@ void ScoreBoard::render() {
     this->newGameButton->render();
 }
 
-void ScoreBoard::tick() const {
-    this->clock->increment();
+void ScoreBoard::setTime(const uint16_t seconds) const {
+    this->clock->setValue(seconds);
 }
 
 void ScoreBoard::handleEvent(const SDL_Event &event) const {
@@ -18,7 +18,7 @@ public:
     ~ScoreBoard() override;
 
     void render() override;
-    void tick() const;
+    void setTime(uint16_t seconds) const;
     void handleEvent(const SDL_Event &event) const;
 
 private:
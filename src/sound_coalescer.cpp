@@ -0,0 +1,80 @@
+#include "sound_coalescer.hpp"
+
+#include <SDL3/SDL.h>
+
+SoundCoalescer::SoundCoalescer(VoicePool* voicePool)
+    : voicePool(voicePool),
+      enabled(true),
+      frequency(SDL_GetPerformanceFrequency()),
+      windowMs(0),
+      windowTicks(0),
+      maxTriggersPerSecond(DEFAULT_MAX_TRIGGERS_PER_SECOND),
+      rateWindowStart(0),
+      rateWindowTriggers(0),
+      playedCount(0),
+      coalescedCount(0),
+      throttledCount(0) {
+    this->setWindowMs(DEFAULT_WINDOW_MS);
+}
+
+SoundCoalescer::~SoundCoalescer() = default;
+
+void SoundCoalescer::setEnabled(const bool newEnabled) {
+    if (this->enabled == newEnabled) {
+        return;
+    }
+
+    this->enabled = newEnabled;
+
+    if (!this->enabled) {
+        this->voicePool->stopAll();
+    }
+
+    SDL_Log("Sound %s", this->enabled ? "enabled" : "disabled");
+}
+
+void SoundCoalescer::setWindowMs(const uint32_t newWindowMs) {
+    this->windowMs = newWindowMs;
+    this->windowTicks = this->frequency * newWindowMs / 1000;
+}
+
+void SoundCoalescer::trigger(const ResourceManager::Sound sound) {
+    if (!this->enabled) {
+        return;
+    }
+
+    if (!isRateLimited(sound)) {
+        this->playedCount++;
+        this->voicePool->play(sound);
+
+        return;
+    }
+
+    const uint64_t now = SDL_GetPerformanceCounter();
+    uint64_t& last = this->lastPlayed[static_cast<size_t>(sound)];
+
+    if (last != 0 && now - last < this->windowTicks) {
+        this->coalescedCount++;
+        return;
+    }
+
+    if (now - this->rateWindowStart >= this->frequency) {
+        this->rateWindowStart = now;
+        this->rateWindowTriggers = 0;
+    }
+
+    if (this->rateWindowTriggers >= this->maxTriggersPerSecond) {
+        this->throttledCount++;
+        return;
+    }
+
+    this->rateWindowTriggers++;
+    this->playedCount++;
+    last = now;
+
+    this->voicePool->play(sound);
+}
+
+bool SoundCoalescer::isRateLimited(const ResourceManager::Sound sound) {
+    return sound != ResourceManager::Sound::EXPLODE;
+}
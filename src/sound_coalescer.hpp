@@ -0,0 +1,60 @@
+#pragma once
+
+#include <array>
+
+#include "resource_manager.hpp"
+#include "voice_pool.hpp"
+
+/**
+ * Sits between gameplay code and the voice pool. Triggers of the same sound that land within the coalescing window are
+ * merged into the one already playing, and the total number of triggers that reach the mixer is capped per second.
+ * Only the sounds a click storm can repeat are limited, the explosion ends the game and always plays. While sound is
+ * disabled triggers return before touching the clock or the mixer.
+ */
+class SoundCoalescer {
+public:
+    static constexpr uint32_t DEFAULT_WINDOW_MS = 30;
+    static constexpr uint32_t DEFAULT_MAX_TRIGGERS_PER_SECOND = 20;
+
+    explicit SoundCoalescer(VoicePool* voicePool);
+    ~SoundCoalescer();
+
+    SoundCoalescer(const SoundCoalescer&) = delete;
+    SoundCoalescer& operator=(const SoundCoalescer&) = delete;
+
+    void trigger(ResourceManager::Sound sound);
+
+    [[nodiscard]] bool isEnabled() const { return this->enabled; }
+    void setEnabled(bool newEnabled);
+
+    [[nodiscard]] uint32_t getWindowMs() const { return this->windowMs; }
+    void setWindowMs(uint32_t newWindowMs);
+
+    [[nodiscard]] uint32_t getMaxTriggersPerSecond() const { return this->maxTriggersPerSecond; }
+    void setMaxTriggersPerSecond(const uint32_t newMax) { this->maxTriggersPerSecond = newMax; }
+
+    [[nodiscard]] uint64_t getPlayedCount() const { return this->playedCount; }
+    [[nodiscard]] uint64_t getCoalescedCount() const { return this->coalescedCount; }
+    [[nodiscard]] uint64_t getThrottledCount() const { return this->throttledCount; }
+
+private:
+    VoicePool* voicePool;
+    bool enabled;
+    uint64_t frequency;
+    uint32_t windowMs;
+    uint64_t windowTicks;
+    uint32_t maxTriggersPerSecond;
+
+    std::array<uint64_t, VoicePool::SOUND_COUNT> lastPlayed{};
+    uint64_t rateWindowStart;
+    uint32_t rateWindowTriggers;
+
+    uint64_t playedCount;
+    uint64_t coalescedCount;
+    uint64_t throttledCount;
+
+    /**
+     * Whether triggers of the sound are coalesced and count towards the per second cap.
+     */
+    static bool isRateLimited(ResourceManager::Sound sound);
+};
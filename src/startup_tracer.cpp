@@ -0,0 +1,105 @@
+#include "startup_tracer.hpp"
+
+#include <format>
+#include <string>
+
+#include <SDL3/SDL.h>
+
+StartupTracer::StartupTracer()
+    : origin(SDL_GetPerformanceCounter()),
+      finishedAt(0),
+      frequency(static_cast<double>(SDL_GetPerformanceFrequency())),
+      finished(false) {
+    this->phases.reserve(32);
+}
+
+StartupTracer& StartupTracer::getInstance() {
+    static StartupTracer instance;
+
+    return instance;
+}
+
+void StartupTracer::begin(const char* name) {
+    if (this->finished) {
+        return;
+    }
+
+    this->open.push_back(this->phases.size());
+    this->phases.push_back(Phase{
+        .name = name,
+        .depth = static_cast<uint8_t>(this->open.size() - 1),
+        .start = SDL_GetPerformanceCounter(),
+        .end = 0,
+    });
+}
+
+void StartupTracer::end() {
+    if (this->finished || this->open.empty()) {
+        return;
+    }
+
+    this->phases[this->open.back()].end = SDL_GetPerformanceCounter();
+    this->open.pop_back();
+}
+
+void StartupTracer::finish(const char* jsonPath) {
+    if (this->finished) {
+        return;
+    }
+
+    while (!this->open.empty()) {
+        this->end();
+    }
+
+    this->finished = true;
+    this->finishedAt = SDL_GetPerformanceCounter();
+
+    SDL_Log("Startup trace (%.3f ms total):", this->toMicroseconds(this->finishedAt - this->origin) / 1000.0);
+
+    for (const auto& [name, depth, start, end]: this->phases) {
+        SDL_Log("  %*s%-*s %10.3f ms (at %10.3f ms)",
+                depth * 2, "",
+                32 - depth * 2, name,
+                this->toMicroseconds(end - start) / 1000.0,
+                this->toMicroseconds(start - this->origin) / 1000.0);
+    }
+
+    if (jsonPath != nullptr && jsonPath[0] != '\0') {
+        this->writeJson(jsonPath);
+    }
+}
+
+double StartupTracer::toMicroseconds(const uint64_t ticks) const {
+    return static_cast<double>(ticks) * 1'000'000.0 / this->frequency;
+}
+
+void StartupTracer::writeJson(const char* path) const {
+    std::string json = std::format(
+        "{{\n  \"total_us\": {:.3f},\n  \"phases\": [\n",
+        this->toMicroseconds(this->finishedAt - this->origin));
+
+    for (size_t i = 0; i < this->phases.size(); i++) {
+        const auto& [name, depth, start, end] = this->phases[i];
+
+        json.append(std::format(
+            "    {{ \"name\": \"{}\", \"depth\": {}, \"start_us\": {:.3f}, \"duration_us\": {:.3f} }}{}\n",
+            name,
+            depth,
+            this->toMicroseconds(start - this->origin),
+            this->toMicroseconds(end - start),
+            i + 1 < this->phases.size() ? "," : ""));
+    }
+
+    json.append("  ]\n}\n");
+
+    SDL_IOStream* io = SDL_IOFromFile(path, "w");
+    if (!io) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't write startup trace to %s: %s", path, SDL_GetError());
+        return;
+    }
+
+    SDL_WriteIO(io, json.data(), json.size());
+    SDL_CloseIO(io);
+
+    SDL_Log("Wrote startup trace to %s", path);
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Records how long each phase of startup takes, from SDL_AppInit up to the first presented frame. Phases can nest;
+ * begin() and end() calls must be balanced.
+ */
+class StartupTracer {
+public:
+    static StartupTracer& getInstance();
+
+    void begin(const char* name);
+    void end();
+
+    /**
+     * Ends every open phase, logs the report and, if a path is given, writes it out as JSON.
+     */
+    void finish(const char* jsonPath);
+
+    [[nodiscard]] bool isFinished() const { return this->finished; }
+
+private:
+    struct Phase {
+        const char* name;
+        uint8_t depth;
+        uint64_t start;
+        uint64_t end;
+    };
+
+    StartupTracer();
+
+    uint64_t origin;
+    uint64_t finishedAt;
+    double frequency;
+    std::vector<Phase> phases;
+    std::vector<size_t> open;
+    bool finished;
+
+    [[nodiscard]] double toMicroseconds(uint64_t ticks) const;
+    void writeJson(const char* path) const;
+};
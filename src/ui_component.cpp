@@ -1,5 +1,7 @@
 #include "ui_component.hpp"
 
+#include "render_stats.hpp"
+
 UiComponent::UiComponent(Context* context, const SDL_FRect& rect)
     : context(context),
       rect(SDL_FRect{
@@ -13,6 +15,6 @@ UiComponent::UiComponent(Context* context, const SDL_FRect& rect)
 UiComponent::~UiComponent() = default;
 
 void UiComponent::render() {
-    SDL_SetRenderDrawColor(this->getContext().getRenderer(), 255, 0, 0, 255);
-    SDL_RenderFillRect(this->getContext().getRenderer(), &this->getRect());
+    RenderStats::setDrawColor(this->getContext().getRenderer(), 255, 0, 0, 255);
+    RenderStats::renderFillRect(this->getContext().getRenderer(), &this->getRect());
 }
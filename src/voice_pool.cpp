@@ -0,0 +1,93 @@
+#include "voice_pool.hpp"
+
+#include <stdexcept>
+
+VoicePool::VoicePool(MIX_Mixer* mixer)
+    : mixer(mixer),
+      sequence(0) {
+    uint8_t first = 0;
+
+    for (size_t i = 0; i < SOUND_COUNT; i++) {
+        const uint8_t count = VOICE_LIMITS[i];
+
+        this->channels[i] = Channel{
+            .audio = nullptr,
+            .first = first,
+            .count = count,
+        };
+
+        first += count;
+    }
+
+    for (Voice& voice: this->voices) {
+        voice.track = MIX_CreateTrack(this->mixer);
+
+        if (!voice.track) {
+            // The destructor doesn't run when the constructor throws, so the tracks created so far are released here
+            for (const Voice& created: this->voices) {
+                if (created.track) {
+                    MIX_DestroyTrack(created.track);
+                }
+            }
+
+            throw std::runtime_error("Couldn't create voice track");
+        }
+
+        MIX_SetTrackStoppedCallback(voice.track, VoicePool::onTrackStopped, &voice);
+    }
+}
+
+VoicePool::~VoicePool() {
+    for (Voice& voice: this->voices) {
+        MIX_DestroyTrack(voice.track);
+    }
+}
+
+void VoicePool::setAudio(const ResourceManager::Sound sound, MIX_Audio* audio) {
+    Channel& channel = this->channels[static_cast<size_t>(sound)];
+
+    channel.audio = audio;
+
+    for (uint8_t i = channel.first; i < channel.first + channel.count; i++) {
+        MIX_SetTrackAudio(this->voices[i].track, audio);
+    }
+}
+
+void VoicePool::play(const ResourceManager::Sound sound) {
+    const Channel& channel = this->channels[static_cast<size_t>(sound)];
+
+    if (channel.audio == nullptr || channel.count == 0) {
+        return;
+    }
+
+    // Prefer an idle voice, otherwise steal the one that has been playing the longest
+    Voice* selected = &this->voices[channel.first];
+
+    for (uint8_t i = channel.first; i < channel.first + channel.count; i++) {
+        Voice& voice = this->voices[i];
+
+        if (!voice.playing.load(std::memory_order_acquire)) {
+            selected = &voice;
+            break;
+        }
+
+        if (voice.sequence < selected->sequence) {
+            selected = &voice;
+        }
+    }
+
+    selected->sequence = ++this->sequence;
+    selected->playing.store(true, std::memory_order_release);
+
+    MIX_PlayTrack(selected->track, 0);
+}
+
+void VoicePool::stopAll() const {
+    MIX_StopAllTracks(this->mixer, 0);
+}
+
+void VoicePool::onTrackStopped(void* userdata, MIX_Track* track) {
+    (void)track;
+
+    static_cast<Voice*>(userdata)->playing.store(false, std::memory_order_release);
+}
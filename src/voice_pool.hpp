@@ -0,0 +1,68 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+
+#include <SDL3_mixer/SDL_mixer.h>
+
+#include "resource_manager.hpp"
+
+/**
+ * A fixed set of preallocated mixer tracks ("voices"). Every sound owns a contiguous range of voices that are bound to
+ * its audio once, so triggering a sound never re-binds a track. When all voices of a sound are busy the one that was
+ * started first is stolen and restarted.
+ */
+class VoicePool {
+public:
+    static constexpr size_t SOUND_COUNT = ResourceManager::SOUND_COUNT;
+
+    /**
+     * The maximum number of simultaneous instances of each sound, indexed by ResourceManager::Sound.
+     */
+    static constexpr std::array<uint8_t, SOUND_COUNT> VOICE_LIMITS = {
+        4, // CLICK
+        4, // FLAG
+        1, // EXPLODE
+    };
+
+    explicit VoicePool(MIX_Mixer* mixer);
+    ~VoicePool();
+
+    VoicePool(const VoicePool&) = delete;
+    VoicePool& operator=(const VoicePool&) = delete;
+
+    void setAudio(ResourceManager::Sound sound, MIX_Audio* audio);
+    void play(ResourceManager::Sound sound);
+    void stopAll() const;
+
+private:
+    static constexpr size_t VOICE_COUNT = [] {
+        size_t count = 0;
+
+        for (const uint8_t limit: VOICE_LIMITS) {
+            count += limit;
+        }
+
+        return count;
+    }();
+
+    struct Voice {
+        MIX_Track* track{nullptr};
+        uint64_t sequence{0};
+        // Cleared from the mixer thread by the track stopped callback
+        std::atomic<bool> playing{false};
+    };
+
+    struct Channel {
+        MIX_Audio* audio{nullptr};
+        uint8_t first{0};
+        uint8_t count{0};
+    };
+
+    MIX_Mixer* mixer;
+    uint64_t sequence;
+    std::array<Voice, VOICE_COUNT> voices;
+    std::array<Channel, SOUND_COUNT> channels;
+
+    static void onTrackStopped(void* userdata, MIX_Track* track);
+};
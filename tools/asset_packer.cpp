@@ -0,0 +1,84 @@
+// Builds the asset pack loaded by AssetPack from every file under an assets directory.
+//
+// Usage: sweepminer_asset_packer <assets directory> <output file>
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include "asset_pack.hpp"
+
+namespace fs = std::filesystem;
+
+int main(const int argc, char* argv[]) {
+    if (argc != 3) {
+        std::cerr << "Usage: " << argv[0] << " <assets directory> <output file>\n";
+        return 1;
+    }
+
+    const fs::path assetsDirectory = argv[1];
+    const fs::path outputPath = argv[2];
+
+    std::vector<fs::path> files;
+
+    for (const fs::directory_entry& entry: fs::recursive_directory_iterator(assetsDirectory)) {
+        if (entry.is_regular_file()) {
+            files.push_back(entry.path());
+        }
+    }
+
+    std::ranges::sort(files);
+
+    AssetPack::Header header{};
+    std::memcpy(header.magic, AssetPack::MAGIC, sizeof(AssetPack::MAGIC));
+    header.version = AssetPack::VERSION;
+    header.count = static_cast<uint32_t>(files.size());
+
+    std::vector<AssetPack::Entry> entries(files.size());
+    std::vector<std::vector<char>> blobs(files.size());
+    uint64_t offset = sizeof(AssetPack::Header) + files.size() * sizeof(AssetPack::Entry);
+
+    for (size_t i = 0; i < files.size(); i++) {
+        const std::string path = (fs::path("assets") / fs::relative(files[i], assetsDirectory)).generic_string();
+
+        if (path.size() >= AssetPack::MAX_PATH_LENGTH) {
+            std::cerr << "Asset path is too long: " << path << "\n";
+            return 1;
+        }
+
+        std::ifstream input(files[i], std::ios::binary);
+        blobs[i].assign(std::istreambuf_iterator(input), std::istreambuf_iterator<char>());
+
+        offset = (offset + AssetPack::ALIGNMENT - 1) / AssetPack::ALIGNMENT * AssetPack::ALIGNMENT;
+
+        std::memcpy(entries[i].path, path.c_str(), path.size());
+        entries[i].offset = offset;
+        entries[i].size = blobs[i].size();
+
+        offset += blobs[i].size();
+    }
+
+    std::ofstream output(outputPath, std::ios::binary | std::ios::trunc);
+    if (!output) {
+        std::cerr << "Couldn't open output file: " << outputPath << "\n";
+        return 1;
+    }
+
+    output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    output.write(reinterpret_cast<const char*>(entries.data()), static_cast<std::streamsize>(entries.size() * sizeof(AssetPack::Entry)));
+
+    for (size_t i = 0; i < files.size(); i++) {
+        while (static_cast<uint64_t>(output.tellp()) < entries[i].offset) {
+            output.put('\0');
+        }
+
+        output.write(blobs[i].data(), static_cast<std::streamsize>(blobs[i].size()));
+    }
+
+    std::cout << "Packed " << files.size() << " assets into " << outputPath.string() << " (" << offset << " bytes)\n";
+
+    return output.good() ? 0 : 1;
+}
@@ -0,0 +1,238 @@
+// Compares two metrics files written with --metrics and fails when the candidate regressed. Every metric is averaged
+// over the intervals of its run, and since all of them measure a cost a metric regresses when the candidate's average
+// exceeds the baseline's by more than its threshold.
+//
+// Usage: sweepminer_metrics_compare <baseline.csv> <candidate.csv> [options]
+//
+//   --threshold=<percent>           Allowed increase for every metric, 10 by default. Percentiles come from histograms
+//                                   that are off by up to 0.8%, so thresholds below 1 flag quantisation noise
+//   --threshold=<metric>=<percent>  Allowed increase for one metric, or for every metric starting with the given prefix
+//                                   when it ends in *, the longest match wins
+//   --min-delta=<value>             Ignore increases smaller than this in absolute terms, 0 by default
+//   --allow-missing                 Don't fail when a baseline metric isn't in the candidate, zone metrics are only
+//                                   written while the profiler is on
+//
+// Exits with 0 when nothing regressed, 1 when something did or a baseline metric is missing from the candidate and 2
+// when the files couldn't be read.
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <ranges>
+#include <string>
+#include <string_view>
+
+namespace {
+    struct Metric {
+        double sum{0.0};
+        uint64_t samples{0};
+
+        [[nodiscard]] double getAverage() const { return this->sum / static_cast<double>(this->samples); }
+    };
+
+    bool ParseDouble(const std::string_view value, double& number) {
+        const auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), number);
+
+        return error == std::errc{} && end == value.data() + value.size();
+    }
+
+    // Metric names holding zone labels are written as quoted fields when they contain commas or quotes
+    std::string UnquoteField(const std::string_view field) {
+        if (field.size() < 2 || !field.starts_with('"') || !field.ends_with('"')) {
+            return std::string(field);
+        }
+
+        std::string unquoted;
+
+        for (size_t i = 1; i < field.size() - 1; i++) {
+            unquoted.push_back(field[i]);
+
+            if (field[i] == '"' && field[i + 1] == '"') {
+                i++;
+            }
+        }
+
+        return unquoted;
+    }
+
+    bool ReadMetrics(const char* path, std::map<std::string, Metric>& metrics) {
+        std::ifstream input(path);
+        if (!input) {
+            std::cerr << "Couldn't open metrics file: " << path << "\n";
+            return false;
+        }
+
+        std::string line;
+        size_t lineNumber = 0;
+
+        while (std::getline(input, line)) {
+            lineNumber++;
+
+            if (line.empty() || line.starts_with("seconds,")) {
+                continue;
+            }
+
+            const size_t first = line.find(',');
+            const size_t last = line.rfind(',');
+            double value = 0.0;
+
+            if (first == std::string::npos || first == last ||
+                !ParseDouble(std::string_view(line).substr(last + 1), value)) {
+                std::cerr << path << ":" << lineNumber << ": malformed row: " << line << "\n";
+                return false;
+            }
+
+            Metric& metric = metrics[UnquoteField(std::string_view(line).substr(first + 1, last - first - 1))];
+            metric.sum += value;
+            metric.samples++;
+        }
+
+        if (metrics.empty()) {
+            std::cerr << "No metrics in " << path << "\n";
+            return false;
+        }
+
+        return true;
+    }
+
+    double GetThreshold(const std::string& metric, const double fallback, const std::map<std::string, double>& overrides) {
+        double threshold = fallback;
+        size_t longest = 0;
+
+        for (const auto& [pattern, percent]: overrides) {
+            const bool isPrefix = pattern.ends_with('*');
+            const std::string_view name = isPrefix ? std::string_view(pattern).substr(0, pattern.size() - 1) : pattern;
+
+            const bool matches = isPrefix ? metric.starts_with(name) : metric == name;
+
+            if (matches && name.size() >= longest) {
+                threshold = percent;
+                longest = name.size();
+            }
+        }
+
+        return threshold;
+    }
+}
+
+int main(const int argc, char* argv[]) {
+    if (argc < 3) {
+        std::cerr << "Usage: " << argv[0]
+                  << " <baseline.csv> <candidate.csv> [--threshold=[<metric>=]<percent>]... [--min-delta=<value>]"
+                  << " [--allow-missing]\n";
+        return 2;
+    }
+
+    double defaultThreshold = 10.0;
+    double minDelta = 0.0;
+    bool allowMissing = false;
+    std::map<std::string, double> overrides;
+
+    for (int i = 3; i < argc; i++) {
+        const std::string_view arg = argv[i];
+
+        if (arg.starts_with("--threshold=")) {
+            const std::string_view value = arg.substr(12);
+            const size_t separator = value.rfind('=');
+            double percent = 0.0;
+
+            if (!ParseDouble(separator == std::string_view::npos ? value : value.substr(separator + 1), percent)) {
+                std::cerr << "Invalid threshold: " << arg << "\n";
+                return 2;
+            }
+
+            if (separator == std::string_view::npos) {
+                defaultThreshold = percent;
+            } else {
+                overrides[std::string(value.substr(0, separator))] = percent;
+            }
+        } else if (arg.starts_with("--min-delta=")) {
+            if (!ParseDouble(arg.substr(12), minDelta)) {
+                std::cerr << "Invalid minimum delta: " << arg << "\n";
+                return 2;
+            }
+        } else if (arg == "--allow-missing") {
+            allowMissing = true;
+        } else {
+            std::cerr << "Unknown argument: " << arg << "\n";
+            return 2;
+        }
+    }
+
+    std::map<std::string, Metric> baseline;
+    std::map<std::string, Metric> candidate;
+
+    if (!ReadMetrics(argv[1], baseline) || !ReadMetrics(argv[2], candidate)) {
+        return 2;
+    }
+
+    size_t maxLen = 6;
+
+    for (const auto& name: baseline | std::views::keys) {
+        maxLen = std::max(maxLen, name.size());
+    }
+
+    std::cout << std::format("{:<{}} {:>12} {:>12} {:>9}  {}\n", "Metric", maxLen, "Baseline", "Candidate", "Change", "Limit");
+
+    size_t regressions = 0;
+    size_t missing = 0;
+
+    for (const auto& [name, metric]: baseline) {
+        const auto it = candidate.find(name);
+
+        if (it == candidate.end()) {
+            std::cout << std::format("{:<{}} {:>12.3f} {:>12} {:>9}  missing\n", name, maxLen, metric.getAverage(), "-", "-");
+            missing++;
+            continue;
+        }
+
+        const double before = metric.getAverage();
+        const double after = it->second.getAverage();
+        const double threshold = GetThreshold(name, defaultThreshold, overrides);
+        const double change = before != 0.0 ? (after - before) / before * 100.0 : (after != 0.0 ? INFINITY : 0.0);
+
+        const bool regressed = after - before > minDelta && change > threshold;
+
+        if (regressed) {
+            regressions++;
+        }
+
+        std::cout << std::format(
+            "{:<{}} {:>12.3f} {:>12.3f} {:>+8.1f}%  {:.1f}%{}\n",
+            name,
+            maxLen,
+            before,
+            after,
+            change,
+            threshold,
+            regressed ? "  REGRESSION" : "");
+    }
+
+    for (const auto& [name, metric]: candidate) {
+        if (!baseline.contains(name)) {
+            std::cout << std::format("{:<{}} {:>12} {:>12.3f} {:>9}  new\n", name, maxLen, "-", metric.getAverage(), "-");
+        }
+    }
+
+    if (missing > 0) {
+        std::cout << missing << " metric(s) missing from the candidate\n";
+    }
+
+    if (regressions > 0) {
+        std::cout << regressions << " metric(s) regressed\n";
+    }
+
+    // A metric that disappeared can't be compared, so it fails the gate like a regression unless that's expected
+    if (regressions > 0 || (missing > 0 && !allowMissing)) {
+        return 1;
+    }
+
+    std::cout << "No regressions\n";
+
+    return 0;
+}